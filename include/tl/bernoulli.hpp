@@ -0,0 +1,134 @@
+#ifndef TL_RANGES_BERNOULLI_HPP
+#define TL_RANGES_BERNOULLI_HPP
+
+#include <ranges>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+
+//tl::views::bernoulli(p, rng) keeps each element of a range independently with probability p, e.g. to sample
+//roughly 1% of an unbounded stream:
+//
+//std::mt19937 rng;
+//for (auto& line : tl::views::getlines(log) | tl::views::bernoulli(0.01, rng)) { ... }
+//
+//Instead of drawing a random number for every element, it draws the length of the gap to the next kept element from a
+//geometric distribution, and steps over the gap with std::ranges::advance, so skipped elements are never read and
+//sized random-access ranges are skipped in O(1).
+//
+//The view refers to rng, which must outlive it. Since every iteration draws new random numbers, the result is an
+//input range.
+
+namespace tl {
+   template <std::ranges::input_range V, std::uniform_random_bit_generator URBG>
+   requires std::ranges::view<V>
+   class bernoulli_view : public std::ranges::view_interface<bernoulli_view<V, URBG>> {
+      using difference_type = std::ranges::range_difference_t<V>;
+
+      V base_;
+      double p_ = 1.0;
+      URBG* rng_ = nullptr;
+      std::geometric_distribution<long long> gap_;
+
+      class cursor {
+         std::ranges::iterator_t<V> current_;
+         bernoulli_view* parent_ = nullptr;
+
+         //Skips to the next element which is kept
+         void skip() {
+            auto& parent = *parent_;
+            if (parent.p_ >= 1.0) return;
+            if (parent.p_ <= 0.0) {
+               std::ranges::advance(current_, std::ranges::end(parent.base_));
+               return;
+            }
+            std::ranges::advance(current_, static_cast<difference_type>(parent.gap_(*parent.rng_)),
+               std::ranges::end(parent.base_));
+         }
+
+      public:
+         static constexpr bool single_pass = true;
+
+         cursor() = default;
+         cursor(std::ranges::iterator_t<V> current, bernoulli_view* parent)
+            : current_(std::move(current)), parent_(parent) {
+            skip();
+         }
+
+         decltype(auto) read() const {
+            return *current_;
+         }
+
+         void next() {
+            ++current_;
+            skip();
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return current_ == std::ranges::end(parent_->base_);
+         }
+         bool equal(cursor const& rhs) const {
+            return current_ == rhs.current_;
+         }
+      };
+
+   public:
+      bernoulli_view() = default;
+      bernoulli_view(V base, double p, URBG& rng)
+         : base_(std::move(base)), p_(p), rng_(std::addressof(rng)),
+         gap_(p > 0.0 && p < 1.0 ? p : 0.5) {}
+
+      auto begin() {
+         return basic_iterator{ cursor{ std::ranges::begin(base_), this } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      double probability() const {
+         return p_;
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R, class URBG>
+   bernoulli_view(R&&, double, URBG&)->bernoulli_view<std::views::all_t<R>, URBG>;
+
+   namespace views {
+      namespace detail {
+         struct bernoulli_fn_base {
+            template <std::ranges::viewable_range R, std::uniform_random_bit_generator URBG>
+            requires std::ranges::input_range<R>
+            auto operator()(R&& r, double p, URBG& rng) const {
+               return bernoulli_view(std::forward<R>(r), p, rng);
+            }
+            template <std::ranges::viewable_range R, std::uniform_random_bit_generator URBG>
+            requires std::ranges::input_range<R>
+            auto operator()(R&& r, double p, std::reference_wrapper<URBG> rng) const {
+               return bernoulli_view(std::forward<R>(r), p, rng.get());
+            }
+         };
+
+         struct bernoulli_fn : bernoulli_fn_base {
+            using bernoulli_fn_base::operator();
+
+            template <std::uniform_random_bit_generator URBG>
+            auto operator()(double p, URBG& rng) const {
+               return pipeable(bind_back(bernoulli_fn_base{}, p, std::ref(rng)));
+            }
+         };
+      }
+
+      constexpr inline detail::bernoulli_fn bernoulli;
+   }
+}
+
+#endif
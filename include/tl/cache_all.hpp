@@ -0,0 +1,136 @@
+#ifndef TL_RANGES_CACHE_ALL_HPP
+#define TL_RANGES_CACHE_ALL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include "basic_iterator.hpp"
+#include "functional/pipeable.hpp"
+
+//tl::views::cache_all turns a single-pass range, such as tl::views::getlines or tl::views::generate, into a
+//random-access one. Elements are pulled from the underlying range the first time any iterator reaches them and stored,
+//so later passes read the stored values instead of evaluating the range again, e.g.
+//
+//auto samples = tl::views::getlines(file) | std::views::transform(parse) | tl::views::cache_all;
+//auto mean = tl::sum(samples) / std::ranges::distance(samples);
+//auto variance = tl::sum(samples | std::views::transform([=](auto x) { return (x - mean) * (x - mean); })) / ...;
+//
+//Elements are kept in a std::deque, which allocates in fixed-size blocks, so the stored elements are never copied or
+//moved as more are added, and references to them stay valid. Copies of the view share the same storage and underlying
+//range, so several consumers only evaluate it once between them. Iterating it isn't thread-safe.
+
+namespace tl {
+   template <std::ranges::input_range V>
+   requires (std::ranges::view<V> &&
+      std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>)
+   class cache_all_view : public std::ranges::view_interface<cache_all_view<V>> {
+      using value_type = std::ranges::range_value_t<V>;
+
+      struct state {
+         V base_;
+         //Set on the first pull, because the base may be single-pass
+         std::optional<std::ranges::iterator_t<V>> current_;
+         std::deque<value_type> values_;
+
+         explicit state(V base) : base_(std::move(base)) {}
+
+         //Pulls elements until element i is stored. Returns whether there is an element i.
+         bool fill_to(std::size_t i) {
+            if (!current_) current_.emplace(std::ranges::begin(base_));
+            while (values_.size() <= i) {
+               if (*current_ == std::ranges::end(base_)) return false;
+               values_.emplace_back(**current_);
+               ++*current_;
+            }
+            return true;
+         }
+      };
+
+      std::shared_ptr<state> state_;
+
+      class cursor {
+         state* state_ = nullptr;
+         std::ptrdiff_t index_ = 0;
+
+      public:
+         cursor() = default;
+         cursor(state* s, std::ptrdiff_t index) : state_(s), index_(index) {}
+
+         value_type& read() const {
+            state_->fill_to(static_cast<std::size_t>(index_));
+            return state_->values_[static_cast<std::size_t>(index_)];
+         }
+
+         void next() {
+            ++index_;
+         }
+         void prev() {
+            --index_;
+         }
+         void advance(std::ptrdiff_t n) {
+            index_ += n;
+         }
+
+         bool equal(cursor const& rhs) const {
+            return index_ == rhs.index_;
+         }
+         bool equal(std::default_sentinel_t) const {
+            return !state_->fill_to(static_cast<std::size_t>(index_));
+         }
+
+         std::ptrdiff_t distance_to(cursor const& rhs) const {
+            return rhs.index_ - index_;
+         }
+      };
+
+   public:
+      cache_all_view() = default;
+      explicit cache_all_view(V base) : state_(std::make_shared<state>(std::move(base))) {}
+
+      auto begin() const {
+         return basic_iterator{ cursor{ state_.get(), 0 } };
+      }
+
+      //The size of a sized base is known without pulling every element
+      auto end() const {
+         if constexpr (std::ranges::sized_range<V>) {
+            return basic_iterator{ cursor{ state_.get(), static_cast<std::ptrdiff_t>(std::ranges::size(state_->base_)) } };
+         }
+         else {
+            return std::default_sentinel;
+         }
+      }
+
+      auto size() const requires std::ranges::sized_range<V> {
+         return std::ranges::size(state_->base_);
+      }
+
+      //How many elements have been pulled from the underlying range so far
+      std::size_t cached() const {
+         return state_->values_.size();
+      }
+   };
+
+   template <class R>
+   cache_all_view(R&&)->cache_all_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct cache_all_fn {
+            template <std::ranges::viewable_range V>
+            constexpr auto operator()(V&& v) const
+               requires (std::ranges::input_range<V> &&
+                  std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>) {
+               return tl::cache_all_view{ std::forward<V>(v) };
+            }
+         };
+      }  // namespace detail
+
+      inline constexpr auto cache_all = pipeable(detail::cache_all_fn{});
+   }
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef TL_RANGES_CACHE_WINDOW_HPP
+#define TL_RANGES_CACHE_WINDOW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <vector>
+#include "basic_iterator.hpp"
+#include "functional/pipeable.hpp"
+#include "functional/bind.hpp"
+#include "utility/non_propagating_cache.hpp"
+
+//tl::views::cache_window(n) is like tl::views::cache_latest, but keeps the last n values it has computed in a ring
+//buffer rather than only the current one. As well as iterating, the view itself can look ahead of and move back behind
+//the current element, without evaluating any element of the underlying range more than once:
+//
+//auto tokens = text | std::views::transform(classify) | tl::views::cache_window(4);
+//for (auto it = tokens.begin(); it != tokens.end(); ++it) {
+//   if (*it == '<' && tokens.peek(1) && *tokens.peek(1) == '=') { ... }
+//}
+//
+//peek(k) for k < n gives a pointer to the element k places after the current one, or nullptr if the range ends before
+//it. backtrack(k) moves the current element back k places, which may be up to lookbehind(). Both refer to the position
+//of the iterator which was most recently incremented, as the view is single-pass.
+
+namespace tl {
+   template <std::ranges::input_range V>
+   requires (std::ranges::view<V> && std::movable<std::ranges::range_value_t<V>> &&
+      std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>)
+   class cache_window_view
+      : public std::ranges::view_interface<cache_window_view<V>> {
+      using value_type = std::ranges::range_value_t<V>;
+
+      //Wrapped so that a window of bools is still made of addressable bools rather than a std::vector<bool>
+      struct slot {
+         value_type value_;
+      };
+
+      struct state {
+         std::ranges::iterator_t<V> current_;
+         //Element i is in slot i % capacity
+         std::vector<slot> window_;
+         //Number of elements pulled from the base
+         std::size_t computed_ = 0;
+         //Index of the current element
+         std::size_t position_ = 0;
+      };
+
+      V base_;
+      std::size_t capacity_ = 1;
+      non_propagating_cache<state> state_;
+
+      //Pulls elements from the base until element i has been computed
+      value_type* at(std::size_t i) {
+         auto& s = *state_;
+         while (s.computed_ <= i) {
+            if (s.current_ == std::ranges::end(base_)) return nullptr;
+            if (s.window_.size() < capacity_) {
+               s.window_.push_back(slot{ value_type(*s.current_) });
+            }
+            else {
+               s.window_[s.computed_ % capacity_].value_ = value_type(*s.current_);
+            }
+            ++s.current_;
+            ++s.computed_;
+         }
+         return &s.window_[i % capacity_].value_;
+      }
+
+      struct cursor {
+         cache_window_view* parent_ = nullptr;
+
+         constexpr static bool single_pass = true;
+
+         cursor() = default;
+         constexpr explicit cursor(cache_window_view* parent) : parent_(parent) {}
+
+         value_type& read() const {
+            return *parent_->at(parent_->state_->position_);
+         }
+
+         void next() {
+            auto& s = *parent_->state_;
+            //Skip over the current element even if it was never read
+            if (s.position_ == s.computed_) parent_->at(s.position_);
+            ++s.position_;
+         }
+
+         bool equal(cursor const& rhs) const {
+            return parent_ == rhs.parent_;
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            auto& s = *parent_->state_;
+            return s.position_ == s.computed_ && s.current_ == std::ranges::end(parent_->base_);
+         }
+      };
+
+   public:
+      cache_window_view() = default;
+      cache_window_view(V base, std::size_t n) : base_(std::move(base)), capacity_(n == 0 ? 1 : n) {}
+
+      auto begin() {
+         state_.emplace(state{ std::ranges::begin(base_), {}, 0, 0 });
+         state_->window_.reserve(capacity_);
+         return basic_iterator{ cursor{ this } };
+      }
+
+      auto end() {
+         return std::default_sentinel;
+      }
+
+      auto size() requires std::ranges::sized_range<V> {
+         return std::ranges::size(base_);
+      }
+
+      //The element k places after the current one, or nullptr if there isn't one. Requires k < window_size().
+      value_type* peek(std::size_t k) {
+         return at(state_->position_ + k);
+      }
+
+      //Moves back k elements. Requires k <= lookbehind().
+      void backtrack(std::size_t k) {
+         state_->position_ -= k;
+      }
+
+      //How many elements before the current one are still in the window
+      std::size_t lookbehind() const {
+         auto& s = *state_;
+         return s.position_ - (s.computed_ - s.window_.size());
+      }
+
+      std::size_t window_size() const {
+         return capacity_;
+      }
+
+      V base() const& requires std::copy_constructible<V> {
+         return base_;
+      }
+      V base()&& { return std::move(base_); }
+   };
+
+   template <class R>
+   cache_window_view(R&&, std::size_t)->cache_window_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct cache_window_fn_base {
+            template <std::ranges::viewable_range V>
+            constexpr auto operator()(V&& v, std::size_t n) const
+               requires (std::ranges::input_range<V> && std::movable<std::ranges::range_value_t<V>> &&
+                  std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>) {
+               return tl::cache_window_view{ std::forward<V>(v), n };
+            }
+         };
+
+         struct cache_window_fn : cache_window_fn_base {
+            using cache_window_fn_base::operator();
+
+            constexpr auto operator()(std::size_t n) const {
+               return pipeable(bind_back(cache_window_fn_base{}, n));
+            }
+         };
+      }  // namespace detail
+
+      inline constexpr detail::cache_window_fn cache_window;
+   }
+}
+
+#endif
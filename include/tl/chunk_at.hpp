@@ -0,0 +1,135 @@
+#ifndef TL_RANGES_CHUNK_AT_HPP
+#define TL_RANGES_CHUNK_AT_HPP
+
+#include <ranges>
+#include <iterator>
+#include <concepts>
+#include "common.hpp"
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+
+//tl::views::chunk_at(offsets) splits a range at precomputed offsets.
+//offsets holds the start of each chunk followed by the end of the last one, so chunk i is [offsets[i], offsets[i+1]).
+//Unlike chunk_by_view, which finds chunk boundaries as it goes, chunk_at_view is random access and sized,
+//so the chunks can be handed out to different threads.
+
+namespace tl {
+   template <std::ranges::random_access_range V, std::ranges::random_access_range O>
+   requires (std::ranges::view<V> && std::ranges::view<O> && std::ranges::sized_range<O> &&
+      std::integral<std::ranges::range_value_t<O>>)
+   class chunk_at_view
+      : public std::ranges::view_interface<chunk_at_view<V, O>> {
+   private:
+      V base_;
+      O offsets_;
+
+      template <bool Const>
+      class cursor {
+         using Parent = maybe_const<Const, chunk_at_view>;
+         using Base = maybe_const<Const, V>;
+
+         Parent* parent_ = nullptr;
+         std::ranges::range_difference_t<O> index_ = 0;
+
+      public:
+         using difference_type = std::ranges::range_difference_t<O>;
+
+         cursor() = default;
+         constexpr cursor(Parent* parent, difference_type index)
+            : parent_(parent), index_(index) {}
+
+         constexpr cursor(cursor<!Const> i) requires Const
+            : parent_(i.parent_), index_(i.index_) {}
+
+         constexpr auto read() const {
+            auto first = std::ranges::begin(parent_->base_);
+            auto offsets = std::ranges::begin(parent_->offsets_);
+            return std::ranges::subrange(
+               first + static_cast<std::ranges::range_difference_t<Base>>(offsets[index_]),
+               first + static_cast<std::ranges::range_difference_t<Base>>(offsets[index_ + 1]));
+         }
+
+         constexpr void next() {
+            ++index_;
+         }
+         constexpr void prev() {
+            --index_;
+         }
+         constexpr void advance(difference_type n) {
+            index_ += n;
+         }
+
+         constexpr bool equal(cursor const& rhs) const {
+            return index_ == rhs.index_;
+         }
+
+         constexpr difference_type distance_to(cursor const& rhs) const {
+            return rhs.index_ - index_;
+         }
+
+         friend class cursor<!Const>;
+      };
+
+   public:
+      chunk_at_view() = default;
+      chunk_at_view(V v, O offsets) : base_(std::move(v)), offsets_(std::move(offsets)) {}
+
+      constexpr auto begin() requires (!simple_view<V> || !simple_view<O>) {
+         return basic_iterator{ cursor<false>(this, 0) };
+      }
+      constexpr auto begin() const requires (std::ranges::random_access_range<const V> && std::ranges::random_access_range<const O>) {
+         return basic_iterator{ cursor<true>(this, 0) };
+      }
+
+      constexpr auto end() requires (!simple_view<V> || !simple_view<O>) {
+         return basic_iterator{ cursor<false>(this, static_cast<std::ranges::range_difference_t<O>>(size())) };
+      }
+      constexpr auto end() const requires (std::ranges::random_access_range<const V> && std::ranges::random_access_range<const O>) {
+         return basic_iterator{ cursor<true>(this, static_cast<std::ranges::range_difference_t<O>>(size())) };
+      }
+
+      //There's one more offset than there are chunks
+      constexpr auto size() const requires std::ranges::sized_range<const O> {
+         auto n = std::ranges::size(offsets_);
+         return n == 0 ? n : n - 1;
+      }
+
+      constexpr V base() const& requires std::copy_constructible<V> {
+         return base_;
+      }
+      constexpr V base()&& { return std::move(base_); }
+
+      constexpr O const& offsets() const {
+         return offsets_;
+      }
+   };
+
+   template <class R, class O>
+   chunk_at_view(R&&, O&&)->chunk_at_view<std::views::all_t<R>, std::views::all_t<O>>;
+
+   namespace views {
+      namespace detail {
+         struct chunk_at_fn_base {
+            template <std::ranges::viewable_range R, std::ranges::viewable_range O>
+            constexpr auto operator()(R&& r, O&& offsets) const
+               requires (std::ranges::random_access_range<R> && std::ranges::random_access_range<O> && std::ranges::sized_range<O>) {
+               return chunk_at_view(std::forward<R>(r), std::forward<O>(offsets));
+            }
+         };
+
+         struct chunk_at_fn : chunk_at_fn_base {
+            using chunk_at_fn_base::operator();
+
+            template <std::ranges::viewable_range O>
+            constexpr auto operator()(O&& offsets) const {
+               return pipeable(bind_back(chunk_at_fn_base{}, std::views::all(std::forward<O>(offsets))));
+            }
+         };
+      }
+
+      constexpr inline detail::chunk_at_fn chunk_at;
+   }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "basic_iterator.hpp"
 #include "utility/semiregular_box.hpp"
 #include "utility/non_propagating_cache.hpp"
+#include "utility/adjacent_mismatch.hpp"
 #include "functional/bind.hpp"
 #include "functional/pipeable.hpp"
 
@@ -24,8 +25,9 @@ namespace tl {
 
          //The first time we call begin or when a cursor is advanced we calculate the end of the current range
          //by walking over the range until we find an adjacent pair that returns false for the predicate.
+         //Contiguous ranges of arithmetic types compared with a standard comparison get a vectorised search.
          constexpr std::ranges::iterator_t<V> find_end_of_current_range(std::ranges::iterator_t<V> it) {
-            auto first_failed = std::adjacent_find(it, std::ranges::end(base_), std::not_fn(func_));
+            auto first_failed = detail::find_adjacent_mismatch(std::move(it), std::ranges::end(base_), func_);
             return std::ranges::next(first_failed, 1, std::ranges::end(base_));
          }
 
@@ -0,0 +1,87 @@
+#ifndef TL_RANGES_CHUNK_BY_BOUNDARIES_HPP
+#define TL_RANGES_CHUNK_BY_BOUNDARIES_HPP
+
+#include <ranges>
+#include <iterator>
+#include <functional>
+#include <vector>
+#include "utility/adjacent_mismatch.hpp"
+#include "utility/parallel.hpp"
+#include "chunk_at.hpp"
+
+//tl::chunk_by_boundaries(r, pred) eagerly computes the groups which tl::views::chunk_by(pred) would produce.
+//The result holds the offset of the start of each group followed by the size of the range, which is the
+//format tl::views::chunk_at expects, so r | tl::views::chunk_at(tl::chunk_by_boundaries(tl::par, r, pred))
+//produces the same groups as chunk_by, but as a sized random-access range.
+//
+//tl::chunk_by_boundaries(tl::par, r, pred) splits the adjacent pairs of r into blocks and searches them in parallel.
+
+namespace tl {
+   namespace detail {
+      //Appends the index of the second element of every adjacent pair in [first_pair, last_pair) for which pred fails
+      template <class R, class F>
+      void find_chunk_boundaries(R& r, F& pred,
+         std::ranges::range_difference_t<R> first_pair, std::ranges::range_difference_t<R> last_pair,
+         std::vector<std::ranges::range_difference_t<R>>& out) {
+         auto begin = std::ranges::begin(r);
+         auto it = begin + first_pair;
+         //The last pair in the block reads one element past it
+         auto last = begin + last_pair + 1;
+         while (true) {
+            it = detail::find_adjacent_mismatch(std::move(it), last, pred);
+            if (it == last) return;
+            ++it;
+            out.push_back(it - begin);
+         }
+      }
+   }
+
+   template <std::ranges::random_access_range R, class F>
+   requires (std::ranges::sized_range<R> &&
+      std::predicate<F&, std::ranges::range_reference_t<R>, std::ranges::range_reference_t<R>>)
+   std::vector<std::ranges::range_difference_t<R>> chunk_by_boundaries(R&& r, F pred) {
+      std::vector<std::ranges::range_difference_t<R>> offsets{ 0 };
+      auto n = std::ranges::distance(r);
+      if (n == 0) return offsets;
+
+      tl::detail::find_chunk_boundaries(r, pred, 0, n - 1, offsets);
+      offsets.push_back(n);
+      return offsets;
+   }
+
+   template <std::ranges::random_access_range R, std::copy_constructible F>
+   requires (std::ranges::sized_range<R> &&
+      std::predicate<F&, std::ranges::range_reference_t<R>, std::ranges::range_reference_t<R>>)
+   std::vector<std::ranges::range_difference_t<R>> chunk_by_boundaries(parallel_policy policy, R&& r, F pred) {
+      using difference_type = std::ranges::range_difference_t<R>;
+      //Don't bother spinning up a thread for less than this many pairs
+      constexpr std::size_t min_pairs_per_block = 1 << 14;
+
+      auto n = std::ranges::distance(r);
+      if (n <= 1) return tl::chunk_by_boundaries(r, std::move(pred));
+
+      auto pairs = static_cast<std::size_t>(n - 1);
+      auto blocks = detail::block_count(policy, pairs, min_pairs_per_block);
+      std::vector<std::vector<difference_type>> block_offsets(blocks);
+
+      detail::parallel_for_blocks(policy, blocks, pairs, [&](std::size_t block, std::size_t first, std::size_t last) {
+         auto block_pred = pred;
+         tl::detail::find_chunk_boundaries(r, block_pred,
+            static_cast<difference_type>(first), static_cast<difference_type>(last), block_offsets[block]);
+      });
+
+      std::size_t total = 2;
+      for (auto const& b : block_offsets) total += b.size();
+
+      std::vector<difference_type> offsets;
+      offsets.reserve(total);
+      offsets.push_back(0);
+      for (auto const& b : block_offsets) {
+         offsets.insert(offsets.end(), b.begin(), b.end());
+      }
+      offsets.push_back(n);
+      return offsets;
+   }
+}
+
+#endif
@@ -4,6 +4,10 @@
 #include <ranges>
 #include <iterator>
 #include <utility>
+#include <optional>
+#include <functional>
+#include <tuple>
+#include <deque>
 #include "common.hpp"
 #include "basic_iterator.hpp"
 #include "utility/semiregular_box.hpp"
@@ -12,27 +16,49 @@
 #include "functional/pipeable.hpp"
 
 namespace tl {
+   namespace detail {
+      //Walks forward from the element after first until the key changes.
+      //Returns the end of the group and, unless that's the end of the range, the key of the first element of the next group,
+      //so that the caller doesn't need to compute it again.
+      template <class Key, class I, class S, class F>
+      constexpr std::pair<I, std::optional<Key>> find_end_of_key_group(I first, S const& last, F& func, Key const& key) {
+         for (++first; first != last; ++first) {
+            auto&& next_key = std::invoke(func, *first);
+            if (next_key != key) {
+               return { std::move(first), Key(std::forward<decltype(next_key)>(next_key)) };
+            }
+         }
+         return { std::move(first), std::nullopt };
+      }
+   }
+
    template <std::ranges::forward_range V, std::invocable<std::ranges::range_reference_t<V>> F>
    requires std::ranges::view<V>
    class chunk_by_key_view 
       : public std::ranges::view_interface<chunk_by_key_view<V,F>> {
    private:
-      using key_type = std::invoke_result_t<F, std::ranges::range_reference_t<V>>;
+      using key_type = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>>;
+
+      struct group_info {
+         key_type key;
+         std::ranges::iterator_t<V> end;
+         std::optional<key_type> next_key;
+      };
 
       V base_;
       //Might need to wrap F in a semiregular_box to ensure the view is moveable and default-initializable
       [[no_unique_address]] semiregular_storage_for<F> func_;
-      //Need to cache the end of the first group so that begin is amortized O(1). Also cache the first key.
-      non_propagating_cache<std::pair<key_type, std::ranges::iterator_t<V>>> first_group_info_;
+      //Need to cache the end of the first group so that begin is amortized O(1). Also cache the first key and the key of the second group.
+      non_propagating_cache<group_info> first_group_info_;
 
       constexpr auto get_first_group_info() {
          if (!first_group_info_) {
             auto it = std::ranges::begin(base_);
             if (it != std::ranges::end(base_)) {
-               auto first_key = std::invoke(func_, *it);
-               auto end_of_first_range = std::ranges::find_if(std::ranges::next(it), std::end(base_), [&](auto&& v) { return std::invoke(func_, v) != first_key; });
+               auto first_key = key_type(std::invoke(func_, *it));
+               auto [end_of_first_range, next_key] = detail::find_end_of_key_group(std::move(it), std::ranges::end(base_), func_, first_key);
 
-               first_group_info_ = std::pair(std::move(first_key), std::move(end_of_first_range));
+               first_group_info_ = group_info{ std::move(first_key), std::move(end_of_first_range), std::move(next_key) };
             }
          }
          return *first_group_info_;
@@ -44,15 +70,23 @@ namespace tl {
          constexpr sentinel(std::ranges::sentinel_t<V> end) : end_(std::move(end)) {}
       };
 
+      //Each element's key is computed exactly once per traversal: finding the end of a group computes the key of the next one,
+      //which the cursor holds on to until it gets there.
       struct cursor {
          std::ranges::iterator_t<V> current_;
          std::ranges::iterator_t<V> end_of_current_range_;
          std::optional<key_type> current_key_;
+         std::optional<key_type> next_key_;
          chunk_by_key_view* parent_;
 
          cursor() = default;
-         constexpr cursor(std::ranges::iterator_t<V> begin, std::ranges::iterator_t<V> end_of_first_group, key_type first_key, chunk_by_key_view* parent)
-            : current_(std::move(begin)), end_of_current_range_(std::move(end_of_first_group)), current_key_(std::move(first_key)), parent_(parent) {
+         //Cursor for an empty range
+         constexpr cursor(std::ranges::iterator_t<V> end, chunk_by_key_view* parent)
+            : current_(end), end_of_current_range_(std::move(end)), parent_(parent) {
+         }
+         constexpr cursor(std::ranges::iterator_t<V> begin, group_info first_group, chunk_by_key_view* parent)
+            : current_(std::move(begin)), end_of_current_range_(std::move(first_group.end)), 
+              current_key_(std::move(first_group.key)), next_key_(std::move(first_group.next_key)), parent_(parent) {
          }
 
          constexpr auto read() const {
@@ -63,9 +97,9 @@ namespace tl {
             current_ = end_of_current_range_;
             if (current_ == std::ranges::end(parent_->base_)) return;
 
-            current_key_ = std::invoke(parent_->func_, *current_);
-            end_of_current_range_ = std::ranges::find_if(std::ranges::next(current_), std::ranges::end(parent_->base_), 
-               [this](auto&& v) { return std::invoke(parent_->func_, v) != *current_key_; });
+            current_key_ = std::move(next_key_);
+            std::tie(end_of_current_range_, next_key_) = 
+               detail::find_end_of_key_group(current_, std::ranges::end(parent_->base_), parent_->func_, *current_key_);
          }
    
          constexpr bool equal(cursor const& rhs) const {
@@ -81,8 +115,10 @@ namespace tl {
       chunk_by_key_view(V v, F f) : base_(std::move(v)), func_(std::move(f)) {}
 
       constexpr auto begin() {
-         auto [first_key, end_of_first_group] = get_first_group_info();
-         return basic_iterator{ cursor{ std::ranges::begin(base_), std::move(end_of_first_group), std::move(first_key), this } };
+         if (std::ranges::begin(base_) == std::ranges::end(base_)) {
+            return basic_iterator{ cursor{ std::ranges::begin(base_), this } };
+         }
+         return basic_iterator{ cursor{ std::ranges::begin(base_), get_first_group_info(), this } };
       }
 
       constexpr auto end() {
@@ -97,6 +133,105 @@ namespace tl {
    template <class R, class F>
    chunk_by_key_view(R&&, F f)->chunk_by_key_view<std::views::all_t<R>, F>;
 
+   //Like chunk_by_key_view, but remembers the key and bounds of every group it has found, so iterating over it again
+   //doesn't run the key function again. Keys are yielded by reference into that cache.
+   template <std::ranges::forward_range V, std::invocable<std::ranges::range_reference_t<V>> F>
+   requires std::ranges::view<V>
+   class cached_chunk_by_key_view
+      : public std::ranges::view_interface<cached_chunk_by_key_view<V, F>> {
+   private:
+      using key_type = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>>;
+
+      struct group {
+         key_type key;
+         std::ranges::iterator_t<V> begin;
+         std::ranges::iterator_t<V> end;
+      };
+
+      struct group_cache {
+         //A deque so that references to keys stay valid as more groups are found
+         std::deque<group> groups;
+         //The key of the first group which hasn't been found yet, if there is one
+         std::optional<key_type> next_key;
+      };
+
+      V base_;
+      //Might need to wrap F in a semiregular_box to ensure the view is moveable and default-initializable
+      [[no_unique_address]] semiregular_storage_for<F> func_;
+      non_propagating_cache<group_cache> cache_;
+
+      constexpr void add_group(std::ranges::iterator_t<V> first, key_type key) {
+         auto [last, next_key] = detail::find_end_of_key_group(first, std::ranges::end(base_), func_, key);
+         cache_->groups.push_back(group{ std::move(key), std::move(first), std::move(last) });
+         cache_->next_key = std::move(next_key);
+      }
+
+      //Find groups until group n is known or we run out. Returns whether group n exists.
+      constexpr bool find_group(std::size_t n) {
+         if (!cache_) {
+            cache_.emplace();
+            auto it = std::ranges::begin(base_);
+            if (it != std::ranges::end(base_)) {
+               auto key = key_type(std::invoke(func_, *it));
+               add_group(std::move(it), std::move(key));
+            }
+         }
+
+         while (cache_->groups.size() <= n && cache_->next_key) {
+            auto key = std::move(*cache_->next_key);
+            add_group(cache_->groups.back().end, std::move(key));
+         }
+         return n < cache_->groups.size();
+      }
+
+      struct cursor {
+         cached_chunk_by_key_view* parent_ = nullptr;
+         std::size_t index_ = 0;
+
+         cursor() = default;
+         constexpr cursor(cached_chunk_by_key_view* parent, std::size_t index)
+            : parent_(parent), index_(index) {
+         }
+
+         constexpr auto read() const {
+            auto& g = parent_->cache_->groups[index_];
+            return std::pair<key_type const&, std::ranges::subrange<std::ranges::iterator_t<V>>>(g.key, { g.begin, g.end });
+         }
+
+         constexpr void next() {
+            ++index_;
+            parent_->find_group(index_);
+         }
+
+         constexpr bool equal(cursor const& rhs) const {
+            return index_ == rhs.index_;
+         }
+         constexpr bool equal(std::default_sentinel_t) const {
+            return index_ >= parent_->cache_->groups.size();
+         }
+      };
+
+   public:
+      cached_chunk_by_key_view() = default;
+      cached_chunk_by_key_view(V v, F f) : base_(std::move(v)), func_(std::move(f)) {}
+
+      constexpr auto begin() {
+         find_group(0);
+         return basic_iterator{ cursor{ this, 0 } };
+      }
+
+      constexpr auto end() {
+         return std::default_sentinel;
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R, class F>
+   cached_chunk_by_key_view(R&&, F f)->cached_chunk_by_key_view<std::views::all_t<R>, F>;
+
    namespace views {
       namespace detail {
          struct chunk_by_key_fn_base {
@@ -118,6 +253,27 @@ namespace tl {
       }
 
       constexpr inline detail::chunk_by_key_fn chunk_by_key;
+
+      namespace detail {
+         struct cached_chunk_by_key_fn_base {
+            template <std::ranges::viewable_range R, std::invocable<std::ranges::range_reference_t<R>> F>
+            constexpr auto operator()(R&& r, F f) const
+               requires std::ranges::forward_range<R> {
+               return cached_chunk_by_key_view(std::forward<R>(r), std::move(f));
+            }
+         };
+
+         struct cached_chunk_by_key_fn : cached_chunk_by_key_fn_base {
+            using cached_chunk_by_key_fn_base::operator();
+
+            template <class F>
+            constexpr auto operator()(F f) const {
+               return pipeable(bind_back(cached_chunk_by_key_fn_base{}, std::move(f)));
+            }
+         };
+      }
+
+      constexpr inline detail::cached_chunk_by_key_fn cached_chunk_by_key;
    }
 }
 
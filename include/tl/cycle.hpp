@@ -1,16 +1,35 @@
 #ifndef TL_RANGES_CYCLE_HPP
 #define TL_RANGES_CYCLE_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <ranges>
+#include <span>
 #include <type_traits>
 #include "functional/pipeable.hpp"
+#include "functional/bind.hpp"
 #include "basic_iterator.hpp"
+#include "repeat.hpp"
+#include "repeat_n.hpp"
+
+//tl::views::cycle repeats a forward range forever, and tl::views::cycle_n(k) repeats it k times.
+//
+//For sized random-access ranges, iterators hold an index from the start of the first cycle and read element
+//index % size, so moving an iterator is plain arithmetic and the result is random access. cycle_n of a sized range is sized.
+//
+//Loops over a cycled range still pay for the wrap-around test or the modulo on every element. segments() gives the range
+//of periods instead, i.e. the base range repeated, so that the loop over each period can be optimised like any other:
+//
+//auto cycled = signal | tl::views::cycle_n(1000);
+//for (auto period : cycled.segments()) { for (auto x : period) { ... } }
+//
+//tl::to copies a sized cycle_n a period at a time in the same way.
 
 namespace tl {
-   template <std::ranges::forward_range V>
+   template <std::ranges::forward_range V, bool Bounded = false>
    requires (std::ranges::view<V>) class cycle_view
-      : public std::ranges::view_interface<cycle_view<V>> {
+      : public std::ranges::view_interface<cycle_view<V, Bounded>> {
       //We need to be able to get to end from begin in O(1).
       template <class T>
       static constexpr bool am_bidirectional = (std::ranges::bidirectional_range<T> &&
@@ -21,26 +40,35 @@ namespace tl {
       static constexpr bool am_random_access = (std::ranges::random_access_range<T> && std::ranges::sized_range<T>);
 
       V base_;
+      //Number of times to repeat the base, if Bounded
+      std::ranges::range_difference_t<V> count_ = 0;
+
+      //For bases which aren't random access, the end of a bounded cycle is at the start of the last+1th cycle
+      struct sentinel {
+         std::ranges::range_difference_t<V> cycles_ = 0;
+      };
 
       template <bool Const>
-      class cursor {
+      class iterator_cursor {
          using Base = std::conditional_t<Const, const V, V>;
 
          std::ranges::iterator_t<Base> current_{};
          Base* base_ = nullptr;
- 
+         //Number of times the end of the base has been passed
+         std::ranges::range_difference_t<Base> cycle_ = 0;
+
       public:
          using difference_type = std::ranges::range_difference_t<Base>;
 
-         cursor() = default;
-         constexpr explicit cursor(std::ranges::iterator_t<Base> current, Base* base)
+         iterator_cursor() = default;
+         constexpr explicit iterator_cursor(std::ranges::iterator_t<Base> current, Base* base)
             : current_{ std::move(current) }, base_{ base }  {}
 
          //const-converting constructor
-         constexpr cursor(cursor<!Const> i) requires Const&& std::convertible_to<
+         constexpr iterator_cursor(iterator_cursor<!Const> i) requires Const&& std::convertible_to<
             std::ranges::iterator_t<V>,
             std::ranges::iterator_t<Base>>
-            : current_{ std::move(i.current_) } {}
+            : current_{ std::move(i.current_) }, base_{ i.base_ }, cycle_{ i.cycle_ } {}
 
          constexpr std::ranges::iterator_t<Base> base()
             const& requires std::copyable<std::ranges::iterator_t<Base>> {
@@ -58,50 +86,171 @@ namespace tl {
             ++current_;
             if (current_ == std::ranges::end(*base_)) {
                current_ = std::ranges::begin(*base_);
+               ++cycle_;
             }
          }
 
          constexpr void prev() requires am_bidirectional<Base> {
             if (current_ == std::ranges::begin(*base_)) {
                current_ = std::ranges::end(*base_);
+               --cycle_;
             }
             --current_;
          }
-     
-         constexpr void advance(difference_type x) requires am_random_access<Base> {
-            auto begin = std::ranges::begin(*base_);
-            auto end = std::ranges::end(*base_);
-            auto size = std::ranges::size(*base_);
-            auto distance_from_begin = current_ - begin;
-            auto offset = (distance_from_begin + x) % size;
-            current_ = begin + static_cast<difference_type>(offset < 0 ? offset + size : offset);
-         }
 
-         constexpr bool equal(const cursor& rhs) const requires std::
+         constexpr bool equal(const iterator_cursor& rhs) const requires std::
             equality_comparable<std::ranges::iterator_t<Base>> {
-            return current_ == rhs.current_;
+            return cycle_ == rhs.cycle_ && current_ == rhs.current_;
+         }
+         constexpr bool equal(sentinel const& s) const {
+            return cycle_ == s.cycles_;
          }
 
-         constexpr auto distance_to(const cursor& rhs) const
+         constexpr auto distance_to(const iterator_cursor& rhs) const
             requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>> {
-            return rhs.current_ - current_;
+            return (rhs.cycle_ - cycle_) * std::ranges::distance(*base_) + (rhs.current_ - current_);
          }
 
-         friend class cursor<!Const>;
+         friend class iterator_cursor<!Const>;
       };
 
+      template <bool Const>
+      class index_cursor {
+         using Base = std::conditional_t<Const, const V, V>;
+
+      public:
+         using difference_type = std::ranges::range_difference_t<Base>;
+
+      private:
+         Base* base_ = nullptr;
+         //Index from the start of the first cycle, which may be negative after moving backwards
+         difference_type index_ = 0;
+
+         constexpr difference_type offset() const {
+            auto size = static_cast<difference_type>(std::ranges::size(*base_));
+            auto offset = index_ % size;
+            return offset < 0 ? offset + size : offset;
+         }
+
+      public:
+         index_cursor() = default;
+         constexpr index_cursor(Base* base, difference_type index) : base_{ base }, index_{ index } {}
+
+         //const-converting constructor
+         constexpr index_cursor(index_cursor<!Const> i) requires Const
+            : base_{ i.base_ }, index_{ i.index_ } {}
+
+         constexpr std::ranges::iterator_t<Base> base() const {
+            return std::ranges::begin(*base_) + offset();
+         }
+
+         constexpr decltype(auto) read() const {
+            return std::ranges::begin(*base_)[offset()];
+         }
+
+         constexpr void next() {
+            ++index_;
+         }
+         constexpr void prev() {
+            --index_;
+         }
+         constexpr void advance(difference_type x) {
+            index_ += x;
+         }
+
+         constexpr bool equal(const index_cursor& rhs) const {
+            return index_ == rhs.index_;
+         }
+
+         constexpr auto distance_to(const index_cursor& rhs) const {
+            return rhs.index_ - index_;
+         }
+
+         friend class index_cursor<!Const>;
+      };
+
+      template <bool Const>
+      using cursor = std::conditional_t<am_random_access<std::conditional_t<Const, const V, V>>,
+         index_cursor<Const>, iterator_cursor<Const>>;
+
+      //Take the base as the const or non-const view which the iterators will use, as some views, such as
+      //std::views::filter, can only be iterated when they aren't const
+      template <bool Const, class Base = std::conditional_t<Const, const V, V>>
+      constexpr auto make_begin(Base& base_ref) const {
+         auto base = std::addressof(base_ref);
+         if constexpr (am_random_access<Base>) {
+            return basic_iterator{ index_cursor<Const>(base, 0) };
+         }
+         else {
+            return basic_iterator{ iterator_cursor<Const>(std::ranges::begin(*base), base) };
+         }
+      }
+
+      template <bool Const, class Base = std::conditional_t<Const, const V, V>>
+      constexpr auto make_end(Base& base_ref) const {
+         if constexpr (!Bounded) {
+            return std::unreachable_sentinel;
+         }
+         else if constexpr (am_random_access<Base>) {
+            auto base = std::addressof(base_ref);
+            return basic_iterator{ index_cursor<Const>(base,
+               count_ * static_cast<std::ranges::range_difference_t<Base>>(std::ranges::size(*base))) };
+         }
+         else {
+            //An empty base has no cycles to go through
+            return sentinel{ std::ranges::empty(base_ref) ? 0 : count_ };
+         }
+      }
+
    public:
       cycle_view() = default;
-      cycle_view(V base) : base_(std::move(base)) {}
+      cycle_view(V base) requires (!Bounded) : base_(std::move(base)) {}
+      cycle_view(V base, std::ranges::range_difference_t<V> count) requires Bounded
+         : base_(std::move(base)), count_(count < 0 ? 0 : count) {}
 
       constexpr auto begin() {
-         return basic_iterator{ cursor<false>(std::ranges::begin(base_), std::addressof(base_)) };
+         return make_begin<false>(base_);
+      }
+      constexpr auto begin() const requires std::ranges::forward_range<const V> {
+         return make_begin<true>(base_);
+      }
+
+      constexpr auto end() {
+         return make_end<false>(base_);
+      }
+      constexpr auto end() const requires std::ranges::forward_range<const V> {
+         return make_end<true>(base_);
+      }
+
+      constexpr auto size() requires (Bounded && std::ranges::sized_range<V>) {
+         return static_cast<std::ranges::range_size_t<V>>(count_) * std::ranges::size(base_);
       }
-      constexpr auto begin() const  {
-         return basic_iterator{ cursor<true>(std::ranges::begin(base_), std::addressof(base_)) };
+      constexpr auto size() const requires (Bounded && std::ranges::sized_range<const V>) {
+         return static_cast<std::ranges::range_size_t<const V>>(count_) * std::ranges::size(base_);
       }
 
-      constexpr auto end() const { return std::unreachable_sentinel; }
+      //The periods of the cycle, each of which is the whole base range
+      constexpr auto segments() const requires std::ranges::forward_range<const V> {
+         auto period = std::ranges::subrange(std::ranges::begin(base_), std::ranges::end(base_));
+         if constexpr (Bounded) {
+            return repeat_n_view(std::move(period), static_cast<std::size_t>(count_));
+         }
+         else {
+            return repeat_view(std::move(period));
+         }
+      }
+
+      //Writes the first out.size() elements to out a period at a time. Used by tl::to.
+      template <class T>
+      void copy_to(std::span<T> out) const
+         requires (Bounded && std::ranges::sized_range<const V> && std::indirectly_copyable<std::ranges::iterator_t<const V>, T*>) {
+         auto out_it = out.begin();
+         for (auto period : segments()) {
+            auto n = std::min(static_cast<std::size_t>(std::ranges::size(period)), static_cast<std::size_t>(out.end() - out_it));
+            out_it = std::ranges::copy(std::ranges::begin(period), std::ranges::next(std::ranges::begin(period), n), out_it).out;
+            if (out_it == out.end()) break;
+         }
+      }
 
       constexpr V base() const& requires std::copy_constructible<V> {
          return base_;
@@ -111,21 +260,41 @@ namespace tl {
 
    template <class R>
    cycle_view(R&&)->cycle_view<std::views::all_t<R>>;
+   template <class R, class N>
+   cycle_view(R&&, N)->cycle_view<std::views::all_t<R>, true>;
 
    namespace views {
       namespace detail {
          struct cycle_fn {
             template <std::ranges::viewable_range V>
-            constexpr auto operator()(V&& v) const 
-            requires (std::ranges::forward_range<V> && 
+            constexpr auto operator()(V&& v) const
+            requires (std::ranges::forward_range<V> &&
                (std::ranges::common_range<V> || !std::ranges::bidirectional_range<V>)) {
                return tl::cycle_view{ std::forward<V>(v) };
             }
          };
+
+         struct cycle_n_fn_base {
+            template <std::ranges::viewable_range V>
+            constexpr auto operator()(V&& v, std::ranges::range_difference_t<V> count) const
+            requires (std::ranges::forward_range<V> &&
+               (std::ranges::common_range<V> || !std::ranges::bidirectional_range<V>)) {
+               return tl::cycle_view<std::views::all_t<V>, true>{ std::views::all(std::forward<V>(v)), count };
+            }
+         };
+
+         struct cycle_n_fn : cycle_n_fn_base {
+            using cycle_n_fn_base::operator();
+
+            constexpr auto operator()(std::ptrdiff_t count) const {
+               return pipeable(bind_back(cycle_n_fn_base{}, count));
+            }
+         };
       }  // namespace detail
 
       inline constexpr auto cycle = pipeable(detail::cycle_fn{});
+      inline constexpr detail::cycle_n_fn cycle_n;
    }  // namespace views
 }  // namespace tl
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,127 @@
+#ifndef TL_RANGES_DISTINCT_HPP
+#define TL_RANGES_DISTINCT_HPP
+
+#include <ranges>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/flat_hash_map.hpp"
+
+//tl::views::distinct drops every element which is equal to one that came before it, keeping the first occurrence,
+//without needing the range to be sorted. e.g. {3, 1, 3, 2, 1} | tl::views::distinct is {3, 1, 2}
+//tl::views::distinct(capacity_hint) reserves room for that many distinct elements up front.
+//
+//The elements seen so far are copied as range_value_t into a tl::flat_hash_set which is owned by the view.
+//It's filled in as the view is iterated, so the result is an input range, and calling begin() again starts afresh.
+//For sorted ranges, or to only drop adjacent duplicates, tl::views::unique is cheaper.
+
+namespace tl {
+   template <std::ranges::input_range V, class Hash = std::hash<std::ranges::range_value_t<V>>,
+      class KeyEqual = std::equal_to<std::ranges::range_value_t<V>>>
+   requires (std::ranges::view<V> &&
+      std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>> &&
+      std::invocable<Hash const&, std::ranges::range_value_t<V> const&>)
+   class distinct_view : public std::ranges::view_interface<distinct_view<V, Hash, KeyEqual>> {
+      using value_type = std::ranges::range_value_t<V>;
+
+      V base_;
+      std::size_t capacity_hint_ = 0;
+      flat_hash_set<value_type, Hash, KeyEqual> seen_;
+
+      class cursor {
+         std::ranges::iterator_t<V> current_;
+         distinct_view* parent_ = nullptr;
+
+         //Skip elements which have been seen, and remember the one which is landed on
+         void satisfy() {
+            while (current_ != std::ranges::end(parent_->base_) &&
+               !parent_->seen_.insert(static_cast<value_type const&>(*current_)).second) {
+               ++current_;
+            }
+         }
+
+      public:
+         static constexpr bool single_pass = true;
+
+         cursor() = default;
+         cursor(std::ranges::iterator_t<V> current, distinct_view* parent)
+            : current_(std::move(current)), parent_(parent) {
+            satisfy();
+         }
+
+         decltype(auto) read() const {
+            return *current_;
+         }
+
+         void next() {
+            ++current_;
+            satisfy();
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return current_ == std::ranges::end(parent_->base_);
+         }
+         bool equal(cursor const& rhs) const {
+            return current_ == rhs.current_;
+         }
+      };
+
+   public:
+      distinct_view() = default;
+      distinct_view(V base, std::size_t capacity_hint = 0)
+         : base_(std::move(base)), capacity_hint_(capacity_hint) {}
+
+      auto begin() {
+         seen_.clear();
+         seen_.reserve(capacity_hint_);
+         return basic_iterator{ cursor{ std::ranges::begin(base_), this } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      std::size_t capacity_hint() const {
+         return capacity_hint_;
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R>
+   distinct_view(R&&)->distinct_view<std::views::all_t<R>>;
+   template <class R>
+   distinct_view(R&&, std::size_t)->distinct_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct distinct_fn_base {
+            template <std::ranges::viewable_range R>
+            requires (std::ranges::input_range<R> &&
+               std::constructible_from<std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>>)
+            auto operator()(R&& r, std::size_t capacity_hint = 0) const {
+               return distinct_view(std::forward<R>(r), capacity_hint);
+            }
+         };
+
+         struct distinct_fn : distinct_fn_base {
+            using distinct_fn_base::operator();
+
+            auto operator()(std::size_t capacity_hint) const {
+               return pipeable(bind_back(distinct_fn_base{}, capacity_hint));
+            }
+         };
+      }
+
+      constexpr inline auto distinct = pipeable(detail::distinct_fn{});
+   }
+}
+
+#endif
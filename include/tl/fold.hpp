@@ -6,6 +6,11 @@
 #include <iterator>
 #include <ranges>
 #include <functional>
+#include <type_traits>
+#include <vector>
+#include "utility/parallel.hpp"
+#include "utility/repeated.hpp"
+#include "strided_span.hpp"
 
 namespace tl {
 	template<class F>
@@ -95,10 +100,67 @@ namespace tl {
 		return fold_left_with_iter(std::move(first), last, std::move(init), f).value;
 	}
 
+	namespace detail {
+		template <class F>
+		constexpr inline bool is_plus = false;
+		template <class T>
+		constexpr inline bool is_plus<std::plus<T>> = true;
+
+		template <class F>
+		constexpr inline bool is_multiplies = false;
+		template <class T>
+		constexpr inline bool is_multiplies<std::multiplies<T>> = true;
+
+		//Folding n copies of the same integer with + or * has a closed form
+		template <class R, class T, class F, class U>
+		concept closed_form_foldable = repeated_range<R> &&
+			(is_plus<std::remove_cvref_t<F>> || is_multiplies<std::remove_cvref_t<F>>) &&
+			std::integral<U> && !std::same_as<U, bool> &&
+			std::convertible_to<T, U> && std::convertible_to<std::ranges::range_reference_t<R>, U>;
+
+		//init + n*x or init * x^n. The arithmetic is done in an unsigned type at least as wide as unsigned int, which
+		//wraps the same way as the step-by-step fold, so the result is identical whenever the fold doesn't overflow.
+		template <class U, class R, class T, class F>
+		constexpr U fold_closed_form(R&& r, T init, F) {
+			using W = std::make_unsigned_t<std::common_type_t<U, unsigned>>;
+			auto n = repeated_count(r);
+			auto x = static_cast<W>(static_cast<U>(repeated_value(r)));
+			auto accum = static_cast<W>(static_cast<U>(std::move(init)));
+			if constexpr (is_plus<std::remove_cvref_t<F>>) {
+				return static_cast<U>(accum + static_cast<W>(n) * x);
+			}
+			else {
+				W power = 1;
+				for (; n != 0; n >>= 1) {
+					if (n & 1) power *= x;
+					x *= x;
+				}
+				return static_cast<U>(accum * power);
+			}
+		}
+
+		//Ranges such as tl::stride_view of a contiguous range, whose elements are evenly spaced in memory
+		template <class R>
+		concept strided_range = requires(R& r) {
+			r.as_strided_span();
+		};
+	}
+
 	template<std::ranges::input_range R, class T,
 		indirectly_binary_left_foldable<T, std::ranges::iterator_t<R>> F>
 	constexpr auto fold_left(R&& r, T init, F f) {
-		return fold_left(std::ranges::begin(std::forward<R>(r)), std::ranges::end(std::forward<R>(r)), std::move(init), f);
+		using U = std::decay_t<std::invoke_result_t<F&, T, std::ranges::range_reference_t<R>>>;
+		if constexpr (detail::closed_form_foldable<R, T, F, U>) {
+			return detail::fold_closed_form<U>(r, std::move(init), f);
+		}
+		//Index the elements directly rather than stepping the view's iterators, which check for the end of the base
+		else if constexpr (detail::strided_range<R>) {
+			auto s = r.as_strided_span();
+			return fold_left(s.begin(), s.end(), std::move(init), f);
+		}
+		else {
+			return fold_left(std::ranges::begin(std::forward<R>(r)), std::ranges::end(std::forward<R>(r)), std::move(init), f);
+		}
 	}
 
 	template<std::input_iterator I, std::sentinel_for<I> S, class T,
@@ -110,7 +172,7 @@ namespace tl {
 	template<std::ranges::input_range R, class T,
 		indirectly_binary_left_foldable<T, std::ranges::iterator_t<R>> F>
 	constexpr auto fold(R&& r, T init, F f) {
-		return fold_left(std::ranges::begin(std::forward<R>(r)), std::ranges::end(std::forward<R>(r)), std::move(init), f);
+		return fold_left(std::forward<R>(r), std::move(init), f);
 	}
 
 	template <std::input_iterator I, std::sentinel_for<I> S,
@@ -206,7 +268,77 @@ namespace tl {
 
 	template<std::ranges::input_range R>
 	constexpr auto sum(R&& r) {
-		return fold_left(std::ranges::begin(std::forward<R>(r)), std::ranges::end(std::forward<R>(r)), std::ranges::range_value_t<R>(), std::plus());
+		return fold_left(std::forward<R>(r), std::ranges::range_value_t<R>(), std::plus());
+	}
+
+	namespace detail {
+		//Folds blocks of r concurrently, then joins their results in order with combine. The first block starts from
+		//init. The others start from init too if SeedWithInit, or otherwise from their first element.
+		template<bool SeedWithInit, class U, class R, class T, class F, class Combine>
+		U parallel_fold_left(parallel_policy policy, R&& r, T init, F& f, Combine& combine) {
+			constexpr std::size_t min_block = 1 << 12;
+			auto n = static_cast<std::size_t>(std::ranges::distance(r));
+			auto blocks = detail::block_count(policy, n, min_block);
+			if (blocks <= 1 || detail::closed_form_foldable<R, T, F, U>) {
+				return fold_left(r, std::move(init), f);
+			}
+
+			using difference_type = std::ranges::range_difference_t<R>;
+			auto begin = std::ranges::begin(r);
+			std::vector<std::optional<U>> results(blocks);
+			U start(std::move(init));
+			detail::parallel_for_blocks(policy, blocks, n, [&](std::size_t block, std::size_t first, std::size_t last) {
+				auto block_f = f;
+				auto it = begin + static_cast<difference_type>(first);
+				auto end = begin + static_cast<difference_type>(last);
+				if (block == 0 || SeedWithInit) {
+					results[block].emplace(fold_left(it, end, U(start), block_f));
+				}
+				else {
+					U accum(*it);
+					results[block].emplace(fold_left(++it, end, std::move(accum), block_f));
+				}
+			});
+
+			U accum = std::move(*results[0]);
+			for (std::size_t block = 1; block < blocks; ++block) {
+				accum = std::invoke(combine, std::move(accum), std::move(*results[block]));
+			}
+			return accum;
+		}
+	}
+
+	//Parallel left fold. r is split into blocks which are folded concurrently on the policy's pool, then the results
+	//of the blocks are folded together with f, so f must be associative and combine two accumulators. That's only
+	//possible when the accumulator and the elements have the same type; use the form which takes combine otherwise.
+	//The first block starts from init and the others from their first element, so init needn't be an identity for f.
+	template<std::ranges::random_access_range R, class T,
+		indirectly_binary_left_foldable<T, std::ranges::iterator_t<R>> F,
+		class U = std::decay_t<std::invoke_result_t<F&, T, std::ranges::range_reference_t<R>>>>
+		requires (std::ranges::sized_range<R>&& std::same_as<U, std::ranges::range_value_t<R>>&&
+			std::copy_constructible<U>&& std::constructible_from<U, std::ranges::range_reference_t<R>>&&
+			std::invocable<F&, U, U>&& std::assignable_from<U&, std::invoke_result_t<F&, U, U>>)
+	U fold_left(parallel_policy policy, R&& r, T init, F f) {
+		return detail::parallel_fold_left<false, U>(policy, r, std::move(init), f, f);
+	}
+
+	//Parallel left fold with a separate operation to join the results of blocks, e.g. a sum of squares is
+	//fold_left(tl::par, r, 0, [](int acc, int x) { return acc + x * x; }, std::plus()). Every block starts from init,
+	//so init must be an identity for combine, and combine must be associative.
+	template<std::ranges::random_access_range R, class T,
+		indirectly_binary_left_foldable<T, std::ranges::iterator_t<R>> F,
+		class Combine,
+		class U = std::decay_t<std::invoke_result_t<F&, T, std::ranges::range_reference_t<R>>>>
+		requires (std::ranges::sized_range<R>&& std::copy_constructible<U>&&
+			std::invocable<Combine&, U, U>&& std::assignable_from<U&, std::invoke_result_t<Combine&, U, U>>)
+	U fold_left(parallel_policy policy, R&& r, T init, F f, Combine combine) {
+		return detail::parallel_fold_left<true, U>(policy, r, std::move(init), f, combine);
+	}
+
+	template<std::ranges::random_access_range R>
+		requires std::ranges::sized_range<R>
+	auto sum(parallel_policy policy, R&& r) {
+		return fold_left(policy, std::forward<R>(r), std::ranges::range_value_t<R>(), std::plus());
 	}
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,321 @@
+#ifndef TL_RANGES_FUSED_HPP
+#define TL_RANGES_FUSED_HPP
+
+#include <ranges>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "common.hpp"
+#include "basic_iterator.hpp"
+#include "functional/compose.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/semiregular_box.hpp"
+#include "utility/non_propagating_cache.hpp"
+
+//The adaptors in tl::fuse are element-wise stages which are merged together when they're composed, so
+//r | tl::fuse::transform(f) | tl::fuse::filter(p) | tl::fuse::transform(g) is a single tl::fused_view with one cursor,
+//rather than three nested views with three layers of iterators and three end checks per element.
+//
+//Supported stages:
+//- tl::fuse::transform(f): like std::views::transform
+//- tl::fuse::filter(p): like std::views::filter
+//- tl::fuse::transform_maybe(f): like tl::views::transform_maybe
+//- tl::fuse::enumerate: like tl::views::enumerate, numbering the elements which reach this stage
+//
+//Stages can be composed before being applied to a range, e.g.
+//auto parse = tl::fuse::transform(tokenize) | tl::fuse::transform_maybe(to_record) | tl::fuse::enumerate;
+//auto records = lines | parse;
+//
+//Each element is run through all of the stages once when the cursor reaches it, and the result of the final stage is
+//cached in the cursor, so stage functions are called once per element per traversal. If the final stage yields an
+//lvalue reference then the cursor stores a pointer, otherwise it stores the value and dereferencing yields a const
+//reference to it. Stages can also be piped into ordinary adaptors, in which case they're applied first.
+//
+//A fused_view is forward if the underlying range is, otherwise input.
+
+namespace tl {
+   namespace detail {
+      struct fused_no_state {};
+
+      //Stages which build a new value from their input store it by value, unless the input is an lvalue reference,
+      //because rvalue inputs refer to temporaries owned by an earlier stage
+      template <class T>
+      using fused_decay_t = std::conditional_t<std::is_lvalue_reference_v<T>, T, std::remove_cvref_t<T>>;
+
+      //Each stage takes its state, the input element, and a continuation which runs the rest of the stages.
+      //It returns false if the element was dropped.
+      template <class F>
+      struct fused_transform_stage {
+         [[no_unique_address]] semiregular_storage_for<F> f_;
+         using state = fused_no_state;
+         template <class In>
+         using output = std::invoke_result_t<F const&, In>;
+
+         template <class T, class K>
+         constexpr bool operator()(state&, T&& t, K&& k) const {
+            return k(std::invoke(f_, std::forward<T>(t)));
+         }
+      };
+
+      template <class P>
+      struct fused_filter_stage {
+         [[no_unique_address]] semiregular_storage_for<P> p_;
+         using state = fused_no_state;
+         template <class In>
+         using output = In;
+
+         template <class T, class K>
+         constexpr bool operator()(state&, T&& t, K&& k) const {
+            if (!std::invoke(p_, t)) return false;
+            return k(std::forward<T>(t));
+         }
+      };
+
+      template <class F>
+      struct fused_transform_maybe_stage {
+         [[no_unique_address]] semiregular_storage_for<F> f_;
+         using state = fused_no_state;
+         template <class In>
+         using output = decltype(*std::declval<std::invoke_result_t<F const&, In>>());
+
+         template <class T, class K>
+         constexpr bool operator()(state&, T&& t, K&& k) const {
+            //Keep references to optionals, so that a T& comes out of an optional<T>&
+            auto&& result = std::invoke(f_, std::forward<T>(t));
+            if (!result) return false;
+            return k(*std::forward<decltype(result)>(result));
+         }
+      };
+
+      struct fused_enumerate_stage {
+         using state = std::size_t;
+         template <class In>
+         using output = std::pair<std::size_t, fused_decay_t<In>>;
+
+         template <class T, class K>
+         constexpr bool operator()(state& count, T&& t, K&& k) const {
+            return k(output<T&&>(count++, std::forward<T>(t)));
+         }
+      };
+
+      template <class In, class... Stages>
+      struct fused_output {
+         using type = In;
+      };
+      template <class In, class Stage, class... Stages>
+      struct fused_output<In, Stage, Stages...> : fused_output<typename Stage::template output<In>, Stages...> {};
+
+      //Cursors are assigned by re-constructing the cached value, since assigning some types,
+      //like pairs of references, would write through to the underlying elements
+      template <class T>
+      class fused_cache : public std::optional<T> {
+      public:
+         fused_cache() = default;
+         fused_cache(fused_cache const&) = default;
+         fused_cache(fused_cache&&) = default;
+
+         fused_cache& operator=(fused_cache const& rhs) {
+            if (rhs) this->emplace(*rhs);
+            else this->reset();
+            return *this;
+         }
+         fused_cache& operator=(fused_cache&& rhs) {
+            if (rhs) this->emplace(std::move(*rhs));
+            else this->reset();
+            return *this;
+         }
+      };
+   }
+
+   template <class... Stages>
+   struct fused_pipeline {
+      std::tuple<Stages...> stages_;
+   };
+
+   template <std::ranges::input_range V, class... Stages>
+   requires std::ranges::view<V>
+   class fused_view : public std::ranges::view_interface<fused_view<V, Stages...>> {
+      V base_;
+      [[no_unique_address]] std::tuple<Stages...> stages_;
+
+      using output_type = typename detail::fused_output<std::ranges::range_reference_t<V>, Stages...>::type;
+      static constexpr bool stores_pointer = std::is_lvalue_reference_v<output_type>;
+      using cache_type = std::conditional_t<stores_pointer,
+         std::remove_reference_t<output_type>*, detail::fused_cache<std::remove_cvref_t<output_type>>>;
+
+      struct sentinel {
+         std::ranges::sentinel_t<V> end_;
+         sentinel() = default;
+         constexpr sentinel(std::ranges::sentinel_t<V> end) : end_(std::move(end)) {}
+      };
+
+      class cursor {
+         std::ranges::iterator_t<V> current_;
+         fused_view* parent_ = nullptr;
+         [[no_unique_address]] std::tuple<typename Stages::state...> states_;
+         cache_type cache_{};
+
+         //Runs the element through stage I onwards, caching the result if it makes it through all of them
+         template <std::size_t I, class T>
+         constexpr bool run(T&& t) {
+            if constexpr (I == sizeof...(Stages)) {
+               if constexpr (stores_pointer) cache_ = std::addressof(t);
+               else cache_.emplace(std::forward<T>(t));
+               return true;
+            }
+            else {
+               return std::get<I>(parent_->stages_)(std::get<I>(states_), std::forward<T>(t),
+                  [this](auto&& out) { return run<I + 1>(std::forward<decltype(out)>(out)); });
+            }
+         }
+
+         //Walk forward until we find end, or an element which makes it through all of the stages
+         constexpr void satisfy() {
+            auto end = std::ranges::end(parent_->base_);
+            for (; current_ != end; ++current_) {
+               if (run<0>(*current_)) return;
+            }
+         }
+
+      public:
+         static constexpr inline bool single_pass = detail::single_pass_iterator<std::ranges::iterator_t<V>>;
+
+         cursor() = default;
+         constexpr explicit cursor(fused_view* parent)
+            : current_(std::ranges::begin(parent->base_)), parent_(parent) {
+            satisfy();
+         }
+
+         constexpr decltype(auto) read() const {
+            if constexpr (stores_pointer) return static_cast<output_type>(*cache_);
+            else return std::as_const(*cache_);
+         }
+
+         constexpr void next() {
+            ++current_;
+            satisfy();
+         }
+
+         constexpr bool equal(cursor const& rhs) const requires std::equality_comparable<std::ranges::iterator_t<V>> {
+            return current_ == rhs.current_;
+         }
+
+         constexpr bool equal(sentinel const& s) const {
+            return current_ == s.end_;
+         }
+      };
+
+      //Need to cache begin so that begin(fused_view) is amortized O(1)
+      non_propagating_cache<cursor> begin_;
+
+   public:
+      fused_view() = default;
+      constexpr fused_view(V base, std::tuple<Stages...> stages)
+         : base_(std::move(base)), stages_(std::move(stages)) {}
+
+      constexpr auto begin() {
+         if constexpr (cursor::single_pass) {
+            return basic_iterator{ cursor(this) };
+         }
+         else {
+            if (!begin_) begin_.emplace(this);
+            return basic_iterator{ *begin_ };
+         }
+      }
+
+      constexpr auto end() {
+         return sentinel{ std::ranges::end(base_) };
+      }
+
+      constexpr V base() const& requires std::copy_constructible<V> {
+         return base_;
+      }
+      constexpr V base()&& { return std::move(base_); }
+
+      constexpr std::tuple<Stages...> const& stages() const& {
+         return stages_;
+      }
+      constexpr std::tuple<Stages...> stages()&& {
+         return std::move(stages_);
+      }
+   };
+
+   namespace detail {
+      template <class T>
+      constexpr inline bool is_fused_view = false;
+      template <class V, class... Stages>
+      constexpr inline bool is_fused_view<fused_view<V, Stages...>> = true;
+
+      template <class T>
+      constexpr inline bool is_fused_pipeline = false;
+      template <class... Stages>
+      constexpr inline bool is_fused_pipeline<fused_pipeline<Stages...>> = true;
+
+      template <class... Stages>
+      struct fused_apply_fn {
+         [[no_unique_address]] fused_pipeline<Stages...> pipeline_;
+
+         template <std::ranges::viewable_range R>
+         constexpr auto operator()(R&& r) const requires std::ranges::input_range<R> {
+            return std::forward<R>(r) | pipeline_;
+         }
+      };
+   }
+
+   //Applying stages to a range
+   template <std::ranges::viewable_range R, class... Stages>
+   requires (std::ranges::input_range<R> && !detail::is_fused_view<std::remove_cvref_t<R>>)
+   constexpr auto operator|(R&& r, fused_pipeline<Stages...> pipeline) {
+      return fused_view<std::views::all_t<R>, Stages...>(std::views::all(std::forward<R>(r)), std::move(pipeline.stages_));
+   }
+
+   //Applying stages to a fused_view appends them to its stages
+   template <class V, class... Stages, class... NewStages>
+   constexpr auto operator|(fused_view<V, Stages...> v, fused_pipeline<NewStages...> pipeline) {
+      auto stages = std::tuple_cat(std::move(v).stages(), std::move(pipeline.stages_));
+      return fused_view<V, Stages..., NewStages...>(std::move(v).base(), std::move(stages));
+   }
+
+   template <class... Stages, class... NewStages>
+   constexpr auto operator|(fused_pipeline<Stages...> lhs, fused_pipeline<NewStages...> rhs) {
+      return fused_pipeline<Stages..., NewStages...>{ std::tuple_cat(std::move(lhs.stages_), std::move(rhs.stages_)) };
+   }
+
+   //Composing with ordinary adaptors
+   template <class... Stages, class Pipe>
+   requires is_pipeable<Pipe>
+   constexpr auto operator|(fused_pipeline<Stages...> lhs, Pipe&& rhs) {
+      return pipeable(compose(std::forward<Pipe>(rhs).f_, detail::fused_apply_fn<Stages...>{ std::move(lhs) }));
+   }
+   template <class Pipe, class... Stages>
+   requires is_pipeable<Pipe>
+   constexpr auto operator|(Pipe&& lhs, fused_pipeline<Stages...> rhs) {
+      return pipeable(compose(detail::fused_apply_fn<Stages...>{ std::move(rhs) }, std::forward<Pipe>(lhs).f_));
+   }
+
+   namespace fuse {
+      template <class F>
+      constexpr auto transform(F f) {
+         return fused_pipeline<detail::fused_transform_stage<F>>{ { { std::move(f) } } };
+      }
+
+      template <class P>
+      constexpr auto filter(P p) {
+         return fused_pipeline<detail::fused_filter_stage<P>>{ { { std::move(p) } } };
+      }
+
+      template <class F>
+      constexpr auto transform_maybe(F f) {
+         return fused_pipeline<detail::fused_transform_maybe_stage<F>>{ { { std::move(f) } } };
+      }
+
+      constexpr inline fused_pipeline<detail::fused_enumerate_stage> enumerate{};
+   }
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "functional/pipeable.hpp"
 #include "utility/semiregular_box.hpp"
 #include "utility/non_propagating_cache.hpp"
+#include "utility/batch_generator.hpp"
 
 namespace tl {
    template <std::invocable<> F>
@@ -17,6 +18,8 @@ namespace tl {
    private:
       [[no_unique_address]] tl::semiregular_storage_for<F> func_;
       tl::non_propagating_cache<std::invoke_result_t<F>> cache_;
+      //Used instead of cache_ for generators which can fill a block of values at once
+      [[no_unique_address]] detail::generation_buffer_for<F> buffer_;
 
       class cursor {
          generate_view* parent_;
@@ -30,15 +33,23 @@ namespace tl {
             : parent_{ parent }, pos_{ 0 } {}
 
          constexpr decltype(auto) read() const {
-            if (!parent_->cache_) {
-               parent_->cache_.emplace(std::invoke(parent_->func_));
+            if constexpr (batch_generator<F>) {
+               return parent_->buffer_.current(parent_->generator(), std::size_t(-1));
+            }
+            else {
+               if (!parent_->cache_) {
+                  parent_->cache_.emplace(std::invoke(parent_->func_));
+               }
+               return parent_->cache_.value();
             }
-            return parent_->cache_.value();
          }
 
          constexpr void next() {
             ++pos_;
-            if (parent_->cache_) {
+            if constexpr (batch_generator<F>) {
+               parent_->buffer_.next(parent_->generator(), std::size_t(-1));
+            }
+            else if (parent_->cache_) {
                parent_->cache_.reset();
             }
             else {
@@ -55,6 +66,11 @@ namespace tl {
          }
       };
 
+      constexpr F& generator() {
+         if constexpr (std::semiregular<F>) return func_;
+         else return *func_;
+      }
+
    public:
       generate_view() = default;
       generate_view(F f) : func_(std::move(f)) {}
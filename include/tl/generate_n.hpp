@@ -1,14 +1,17 @@
 #ifndef TL_RANGES_GENERATE_N_HPP
 #define TL_RANGES_GENERATE_N_HPP
 
+#include <algorithm>
 #include <iterator>
 #include <ranges>
+#include <span>
 #include <type_traits>
 #include "common.hpp"
 #include "basic_iterator.hpp"
 #include "functional/pipeable.hpp"
 #include "utility/semiregular_box.hpp"
 #include "utility/non_propagating_cache.hpp"
+#include "utility/batch_generator.hpp"
 
 namespace tl {
    template <std::invocable<> F>
@@ -17,6 +20,8 @@ namespace tl {
    private:
       [[no_unique_address]] tl::semiregular_storage_for<F> func_;
       tl::non_propagating_cache<std::invoke_result_t<F>> cache_;
+      //Used instead of cache_ for generators which can fill a block of values at once
+      [[no_unique_address]] detail::generation_buffer_for<F> buffer_;
       std::size_t n_;
 
       class cursor {
@@ -31,15 +36,23 @@ namespace tl {
             : parent_{ parent }, pos_{ n } {}
 
          constexpr decltype(auto) read() const {
-            if (!parent_->cache_) {
-               parent_->cache_.emplace(std::invoke(parent_->func_));
+            if constexpr (batch_generator<F>) {
+               return parent_->buffer_.current(parent_->generator(), pos_);
+            }
+            else {
+               if (!parent_->cache_) {
+                  parent_->cache_.emplace(std::invoke(parent_->func_));
+               }
+               return parent_->cache_.value();
             }
-            return parent_->cache_.value();
          }
 
          constexpr void next() {
             --pos_;
-            if (parent_->cache_) {
+            if constexpr (batch_generator<F>) {
+               parent_->buffer_.next(parent_->generator(), pos_ + 1);
+            }
+            else if (parent_->cache_) {
                parent_->cache_.reset();
             }
             else {
@@ -64,6 +77,11 @@ namespace tl {
          }
       };
 
+      constexpr F& generator() {
+         if constexpr (std::semiregular<F>) return func_;
+         else return *func_;
+      }
+
    public:
       generate_n_view() = default;
       generate_n_view(F f, std::size_t n) : func_(std::move(f)), n_(n) {}
@@ -75,6 +93,15 @@ namespace tl {
       constexpr auto end() const {
          return std::default_sentinel;
       }
+
+      constexpr std::size_t size() const {
+         return n_;
+      }
+
+      //Writes the elements to out in bulk, the same as iterating from begin(). Used by tl::to.
+      void copy_to(std::span<std::remove_cvref_t<std::invoke_result_t<F&>>> out) requires batch_generator<F> {
+         buffer_.copy_to(generator(), out.first(std::min(out.size(), n_)));
+      }
    };
 
    template <class T>
@@ -0,0 +1,96 @@
+#ifndef TL_RANGES_GROUP_AGGREGATE_HPP
+#define TL_RANGES_GROUP_AGGREGATE_HPP
+
+#include <ranges>
+#include <iterator>
+#include <functional>
+#include <concepts>
+#include <vector>
+#include "utility/flat_hash_map.hpp"
+#include "utility/parallel.hpp"
+
+//tl::group_aggregate(r, key_fn, init, op) folds every group of elements with equal keys in one pass over r,
+//without requiring that r is sorted by key. It returns a tl::flat_hash_map from each key to
+//op(...op(op(init, e1), e2)..., en) for the elements e1...en with that key, in the order they appear in r.
+//
+//e.g. summing sales by region:
+//auto totals = tl::group_aggregate(sales, &sale::region, 0.0, [](double acc, sale const& s) { return acc + s.amount; });
+//
+//tl::group_aggregate(tl::par, r, key_fn, init, op, merge) aggregates blocks of r into separate tables in parallel,
+//then combines the per-block results for each key with merge(accumulated, block_result). merge defaults to op, which
+//is right whenever op can combine two accumulators, as with std::plus.
+
+namespace tl {
+   template <class R, class KeyFn>
+   using group_key_t = std::remove_cvref_t<std::invoke_result_t<KeyFn&, std::ranges::range_reference_t<R>>>;
+
+   namespace detail {
+      template <class R, class KeyFn, class T, class Op>
+      concept group_aggregatable = std::ranges::input_range<R> &&
+         std::invocable<KeyFn&, std::ranges::range_reference_t<R>> &&
+         std::copy_constructible<T> && std::movable<T> &&
+         std::invocable<Op&, T, std::ranges::range_reference_t<R>> &&
+         std::assignable_from<T&, std::invoke_result_t<Op&, T, std::ranges::range_reference_t<R>>>;
+
+      template <class Map, class I, class S, class KeyFn, class T, class Op>
+      void group_aggregate_into(Map& result, I first, S last, KeyFn& key_fn, T const& init, Op& op) {
+         for (; first != last; ++first) {
+            auto&& element = *first;
+            auto& accumulator = result.try_emplace(std::invoke(key_fn, element), init).first->second;
+            accumulator = std::invoke(op, std::move(accumulator), std::forward<decltype(element)>(element));
+         }
+      }
+   }
+
+   template <std::ranges::input_range R, class KeyFn, class T, class Op>
+   requires detail::group_aggregatable<R, KeyFn, T, Op>
+   auto group_aggregate(R&& r, KeyFn key_fn, T init, Op op) {
+      flat_hash_map<group_key_t<R, KeyFn>, T> result;
+      detail::group_aggregate_into(result, std::ranges::begin(r), std::ranges::end(r), key_fn, init, op);
+      return result;
+   }
+
+   template <std::ranges::random_access_range R, std::copy_constructible KeyFn, class T, std::copy_constructible Op, class Merge>
+   requires (std::ranges::sized_range<R> && detail::group_aggregatable<R, KeyFn, T, Op> &&
+      std::invocable<Merge&, T, T&> && std::assignable_from<T&, std::invoke_result_t<Merge&, T, T&>>)
+   auto group_aggregate(parallel_policy policy, R&& r, KeyFn key_fn, T init, Op op, Merge merge) {
+      using map_type = flat_hash_map<group_key_t<R, KeyFn>, T>;
+      //Each block builds its own table, so blocks need to be big enough to amortise that
+      constexpr std::size_t min_block = 1 << 15;
+
+      auto n = static_cast<std::size_t>(std::ranges::distance(r));
+      auto blocks = detail::block_count(policy, n, min_block);
+      std::vector<map_type> tables(blocks);
+
+      detail::parallel_for_blocks(policy, blocks, n, [&](std::size_t block, std::size_t first, std::size_t last) {
+         auto block_key_fn = key_fn;
+         auto block_op = op;
+         auto begin = std::ranges::begin(r);
+         using difference_type = std::ranges::range_difference_t<R>;
+         detail::group_aggregate_into(tables[block],
+            begin + static_cast<difference_type>(first), begin + static_cast<difference_type>(last),
+            block_key_fn, init, block_op);
+      });
+
+      auto result = std::move(tables.front());
+      for (auto table = std::next(tables.begin()); table != tables.end(); ++table) {
+         for (auto& [key, value] : *table) {
+            auto [it, inserted] = result.try_emplace(std::move(key), value);
+            if (!inserted) {
+               it->second = std::invoke(merge, std::move(it->second), value);
+            }
+         }
+      }
+      return result;
+   }
+
+   template <std::ranges::random_access_range R, std::copy_constructible KeyFn, class T, std::copy_constructible Op>
+   requires (std::ranges::sized_range<R> && detail::group_aggregatable<R, KeyFn, T, Op> &&
+      std::invocable<Op&, T, T&> && std::assignable_from<T&, std::invoke_result_t<Op&, T, T&>>)
+   auto group_aggregate(parallel_policy policy, R&& r, KeyFn key_fn, T init, Op op) {
+      auto merge = op;
+      return tl::group_aggregate(policy, std::forward<R>(r), std::move(key_fn), std::move(init), std::move(op), std::move(merge));
+   }
+}
+
+#endif
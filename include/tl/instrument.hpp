@@ -0,0 +1,363 @@
+#ifndef TL_RANGES_INSTRUMENT_HPP
+#define TL_RANGES_INSTRUMENT_HPP
+
+#include <ranges>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "common.hpp"
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+
+//tl::views::instrument(name) passes a range through unchanged, but counts the operations performed on it and its
+//iterators: calls to begin and end, increments, decrements, advances, dereferences, comparisons, distance calculations,
+//and iterator copies and moves. Counts are recorded against name in tl::instrument_registry::global(), so every
+//instrument view with the same name adds to the same counters, and they can be printed with dump().
+//
+//tl::views::instrument(name, tl::instrument_timing::on) also measures the time spent in each operation. This calls
+//std::chrono::steady_clock twice per operation, so it's only meaningful for operations that do real work, e.g.
+//
+//auto r = lines | tl::views::transform_maybe(parse) | tl::views::instrument("parse");
+//for (auto&& x : r) { ... }
+//tl::instrument_registry::global().dump(std::cout);
+//
+//Operations are counted at the wrapped iterator, so when instrumenting a pipeline, place instrument views between
+//the stages you're interested in.
+
+namespace tl {
+   enum class instrument_op {
+      begin,
+      end,
+      increment,
+      decrement,
+      advance,
+      dereference,
+      compare,
+      distance,
+      iterator_copy,
+      iterator_move,
+   };
+
+   enum class instrument_timing {
+      off,
+      on
+   };
+
+   class instrument_counters {
+   public:
+      static constexpr std::size_t op_count = static_cast<std::size_t>(instrument_op::iterator_move) + 1;
+
+      static constexpr std::string_view op_name(instrument_op op) {
+         constexpr std::array<std::string_view, op_count> names{
+            "begin", "end", "increment", "decrement", "advance", "dereference", "compare", "distance", "iterator_copy", "iterator_move"
+         };
+         return names[static_cast<std::size_t>(op)];
+      }
+
+      void add(instrument_op op, std::uint64_t n = 1) {
+         counts_[static_cast<std::size_t>(op)].fetch_add(n, std::memory_order_relaxed);
+      }
+      void add_time(instrument_op op, std::chrono::nanoseconds t) {
+         nanoseconds_[static_cast<std::size_t>(op)].fetch_add(static_cast<std::uint64_t>(t.count()), std::memory_order_relaxed);
+      }
+
+      std::uint64_t count(instrument_op op) const {
+         return counts_[static_cast<std::size_t>(op)].load(std::memory_order_relaxed);
+      }
+      std::chrono::nanoseconds time(instrument_op op) const {
+         return std::chrono::nanoseconds(nanoseconds_[static_cast<std::size_t>(op)].load(std::memory_order_relaxed));
+      }
+
+      void reset() {
+         for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+         for (auto& t : nanoseconds_) t.store(0, std::memory_order_relaxed);
+      }
+
+   private:
+      std::array<std::atomic<std::uint64_t>, op_count> counts_{};
+      std::array<std::atomic<std::uint64_t>, op_count> nanoseconds_{};
+   };
+
+   class instrument_registry {
+   public:
+      static instrument_registry& global() {
+         static instrument_registry registry;
+         return registry;
+      }
+
+      //The counters for name, created on first use. The reference stays valid for the lifetime of the registry.
+      instrument_counters& counters(std::string_view name) {
+         std::scoped_lock lock(mutex_);
+         auto it = counters_.find(name);
+         if (it == counters_.end()) {
+            it = counters_.emplace(std::string(name), std::make_unique<instrument_counters>()).first;
+         }
+         return *it->second;
+      }
+
+      void reset() {
+         std::scoped_lock lock(mutex_);
+         for (auto& [name, c] : counters_) c->reset();
+      }
+
+      //Writes one line per name listing the operations that were performed, with times if any were measured
+      void dump(std::ostream& os) const {
+         std::scoped_lock lock(mutex_);
+         for (auto& [name, c] : counters_) {
+            os << name << ':';
+            for (std::size_t i = 0; i < instrument_counters::op_count; ++i) {
+               auto op = static_cast<instrument_op>(i);
+               if (c->count(op) == 0) continue;
+               os << ' ' << instrument_counters::op_name(op) << '=' << c->count(op);
+               if (auto t = c->time(op); t.count() != 0) {
+                  os << " (" << t.count() << "ns)";
+               }
+            }
+            os << '\n';
+         }
+      }
+
+   private:
+      mutable std::mutex mutex_;
+      std::map<std::string, std::unique_ptr<instrument_counters>, std::less<>> counters_;
+   };
+
+   namespace detail {
+      //Counts an operation on construction, and if timing is enabled, records how long it took on destruction.
+      //Does nothing without counters, as for value-initialized iterators and default-constructed views.
+      class instrument_scope {
+         instrument_counters* counters_;
+         instrument_op op_;
+         bool timed_;
+         std::chrono::steady_clock::time_point start_;
+
+      public:
+         instrument_scope(instrument_counters* counters, instrument_op op, bool timed)
+            : counters_(counters), op_(op), timed_(timed && counters) {
+            if (!counters_) return;
+            counters_->add(op_);
+            if (timed_) start_ = std::chrono::steady_clock::now();
+         }
+         ~instrument_scope() {
+            if (timed_) counters_->add_time(op_, std::chrono::steady_clock::now() - start_);
+         }
+         instrument_scope(instrument_scope const&) = delete;
+         instrument_scope& operator=(instrument_scope const&) = delete;
+      };
+   }
+
+   template <std::ranges::input_range V>
+   requires std::ranges::view<V>
+   class instrument_view : public std::ranges::view_interface<instrument_view<V>> {
+      V base_;
+      instrument_counters* counters_ = nullptr;
+      bool timed_ = false;
+
+      detail::instrument_scope record(instrument_op op) const {
+         return { counters_, op, timed_ };
+      }
+
+      template <bool Const>
+      class sentinel {
+         using Base = std::conditional_t<Const, const V, V>;
+         std::ranges::sentinel_t<Base> end_{};
+
+      public:
+         sentinel() = default;
+         constexpr explicit sentinel(std::ranges::sentinel_t<Base> end)
+            : end_{ std::move(end) } {}
+
+         constexpr sentinel(sentinel<!Const> other) requires Const&& std::
+            convertible_to<std::ranges::sentinel_t<V>,
+            std::ranges::sentinel_t<Base>>
+            : end_{ std::move(other.end_) } {}
+
+         constexpr auto end() const {
+            return end_;
+         }
+
+         friend class sentinel<!Const>;
+      };
+
+      template <bool Const>
+      class cursor {
+         using Base = std::conditional_t<Const, const V, V>;
+         std::ranges::iterator_t<Base> current_{};
+         instrument_counters* counters_ = nullptr;
+         bool timed_ = false;
+
+         detail::instrument_scope record(instrument_op op) const {
+            return { counters_, op, timed_ };
+         }
+
+      public:
+         static constexpr bool single_pass = detail::single_pass_iterator<std::ranges::iterator_t<Base>>;
+
+         cursor() = default;
+         cursor(std::ranges::iterator_t<Base> current, instrument_counters* counters, bool timed)
+            : current_{ std::move(current) }, counters_(counters), timed_(timed) {}
+
+         cursor(cursor<!Const> i) requires Const&& std::convertible_to<
+            std::ranges::iterator_t<V>,
+            std::ranges::iterator_t<Base>>
+            : current_{ std::move(i.current_) }, counters_(i.counters_), timed_(i.timed_) {}
+
+         cursor(cursor const& other) requires std::copy_constructible<std::ranges::iterator_t<Base>>
+            : current_(other.current_), counters_(other.counters_), timed_(other.timed_) {
+            if (counters_) counters_->add(instrument_op::iterator_copy);
+         }
+         cursor(cursor&& other)
+            : current_(std::move(other.current_)), counters_(other.counters_), timed_(other.timed_) {
+            if (counters_) counters_->add(instrument_op::iterator_move);
+         }
+         cursor& operator=(cursor const& other) requires std::copyable<std::ranges::iterator_t<Base>> {
+            current_ = other.current_;
+            counters_ = other.counters_;
+            timed_ = other.timed_;
+            if (counters_) counters_->add(instrument_op::iterator_copy);
+            return *this;
+         }
+         cursor& operator=(cursor&& other) {
+            current_ = std::move(other.current_);
+            counters_ = other.counters_;
+            timed_ = other.timed_;
+            if (counters_) counters_->add(instrument_op::iterator_move);
+            return *this;
+         }
+
+         decltype(auto) read() const {
+            auto scope = record(instrument_op::dereference);
+            return *current_;
+         }
+
+         void next() {
+            auto scope = record(instrument_op::increment);
+            ++current_;
+         }
+
+         void prev() requires std::ranges::bidirectional_range<Base> {
+            auto scope = record(instrument_op::decrement);
+            --current_;
+         }
+         void advance(std::ranges::range_difference_t<Base> x) requires std::ranges::random_access_range<Base> {
+            auto scope = record(instrument_op::advance);
+            current_ += x;
+         }
+
+         bool equal(const cursor& rhs) const requires std::equality_comparable<std::ranges::iterator_t<Base>> {
+            auto scope = record(instrument_op::compare);
+            return current_ == rhs.current_;
+         }
+
+         bool equal(const sentinel<Const>& rhs) const {
+            auto scope = record(instrument_op::compare);
+            return current_ == rhs.end();
+         }
+
+         auto distance_to(const cursor& rhs) const
+            requires std::sized_sentinel_for<std::ranges::iterator_t<Base>, std::ranges::iterator_t<Base>> {
+            auto scope = record(instrument_op::distance);
+            return rhs.current_ - current_;
+         }
+
+         auto distance_to(const sentinel<Const>& rhs) const
+            requires std::sized_sentinel_for<std::ranges::sentinel_t<Base>, std::ranges::iterator_t<Base>> {
+            auto scope = record(instrument_op::distance);
+            return rhs.end() - current_;
+         }
+
+         friend class cursor<!Const>;
+      };
+
+   public:
+      instrument_view() = default;
+      instrument_view(V base, instrument_counters& counters, instrument_timing timing = instrument_timing::off)
+         : base_(std::move(base)), counters_(&counters), timed_(timing == instrument_timing::on) {}
+
+      auto begin() requires (!simple_view<V>) {
+         auto scope = record(instrument_op::begin);
+         return tl::basic_iterator{ cursor<false>(std::ranges::begin(base_), counters_, timed_) };
+      }
+      auto begin() const requires std::ranges::range<const V> {
+         auto scope = record(instrument_op::begin);
+         return tl::basic_iterator{ cursor<true>(std::ranges::begin(base_), counters_, timed_) };
+      }
+
+      auto end() requires (!simple_view<V> && !std::ranges::common_range<V>) {
+         auto scope = record(instrument_op::end);
+         return sentinel<false>{std::ranges::end(base_)};
+      }
+      auto end() requires (!simple_view<V> && std::ranges::common_range<V>) {
+         auto scope = record(instrument_op::end);
+         return tl::basic_iterator{ cursor<false>(std::ranges::end(base_), counters_, timed_) };
+      }
+      auto end() const requires (std::ranges::range<const V> && !std::ranges::common_range<const V>) {
+         auto scope = record(instrument_op::end);
+         return sentinel<true>{std::ranges::end(base_)};
+      }
+      auto end() const requires std::ranges::common_range<const V> {
+         auto scope = record(instrument_op::end);
+         return tl::basic_iterator{ cursor<true>(std::ranges::end(base_), counters_, timed_) };
+      }
+
+      constexpr auto size() requires std::ranges::sized_range<V> {
+         return std::ranges::size(base_);
+      }
+      constexpr auto size() const requires std::ranges::sized_range<const V> {
+         return std::ranges::size(base_);
+      }
+
+      instrument_counters& counters() const {
+         return *counters_;
+      }
+
+      constexpr V base() const& requires std::copy_constructible<V> {
+         return base_;
+      }
+      constexpr V base()&& { return std::move(base_); }
+   };
+
+   template <class R>
+   instrument_view(R&&, instrument_counters&)->instrument_view<std::views::all_t<R>>;
+   template <class R>
+   instrument_view(R&&, instrument_counters&, instrument_timing)->instrument_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct instrument_fn_base {
+            template <std::ranges::viewable_range R>
+            auto operator()(R&& r, instrument_counters* counters, instrument_timing timing) const
+               requires std::ranges::input_range<R> {
+               return instrument_view(std::forward<R>(r), *counters, timing);
+            }
+         };
+
+         struct instrument_fn : instrument_fn_base {
+            using instrument_fn_base::operator();
+
+            template <std::ranges::viewable_range R>
+            auto operator()(R&& r, std::string_view name, instrument_timing timing = instrument_timing::off) const
+               requires std::ranges::input_range<R> {
+               return instrument_view(std::forward<R>(r), instrument_registry::global().counters(name), timing);
+            }
+
+            //The counters are looked up once, when the adaptor is created
+            auto operator()(std::string_view name, instrument_timing timing = instrument_timing::off) const {
+               return pipeable(bind_back(instrument_fn_base{}, &instrument_registry::global().counters(name), timing));
+            }
+         };
+      }
+
+      constexpr inline detail::instrument_fn instrument;
+   }
+}
+
+#endif
@@ -0,0 +1,467 @@
+#ifndef TL_RANGES_MDSPAN_HPP
+#define TL_RANGES_MDSPAN_HPP
+
+//tl::mdspan is a multidimensional view of contiguous storage, following the interface of C++23's std::mdspan:
+//tl::extents, which can be static or dynamic per dimension, and the layout_right (row-major), layout_left
+//(column-major) and layout_stride mappings. Elements are accessed with m(i, j, ...) or m[std::array{ i, j, ... }], as
+//C++20 has no multidimensional operator[].
+//
+//tl::submdspan(m, slices...) takes an index, a [first, last) pair or tl::full_extent per dimension and gives a
+//layout_stride mdspan of the selected elements, dropping the dimensions which were indexed.
+//
+//For 2D mdspans, tl::views::rows, tl::views::columns and tl::views::tiles(h, w) give random-access ranges of the rows
+//and columns, as tl::strided_spans, and of h x w submdspans in row-major order, with smaller tiles at the edges as with
+//tl::views::chunk. Positions are computed with integer arithmetic rather than by nesting chunk and stride views, e.g.
+//
+//auto image = tl::as_mdspan(pixels, height, width);
+//for (auto tile : image | tl::views::tiles(16, 16)) { ... tile(y, x) ... }
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "functional/pipeable.hpp"
+#include "functional/bind.hpp"
+#include "strided_span.hpp"
+
+namespace tl {
+   inline constexpr std::size_t dynamic_extent = std::dynamic_extent;
+
+   template <class IndexType, std::size_t... Extents>
+   class extents {
+      static constexpr std::array<std::size_t, sizeof...(Extents)> static_extents_ = { Extents... };
+
+      //Static extents are stored too, so that extent(r) needn't branch
+      std::array<IndexType, sizeof...(Extents)> extents_ = { static_cast<IndexType>(Extents == dynamic_extent ? 0 : Extents)... };
+
+   public:
+      using index_type = IndexType;
+      using size_type = std::make_unsigned_t<IndexType>;
+      using rank_type = std::size_t;
+
+      static constexpr rank_type rank() noexcept { return sizeof...(Extents); }
+      static constexpr rank_type rank_dynamic() noexcept { return ((Extents == dynamic_extent) + ... + 0); }
+      static constexpr std::size_t static_extent(rank_type r) noexcept { return static_extents_[r]; }
+
+      constexpr extents() = default;
+
+      //Takes either the dynamic extents in order, or all of them
+      template <std::integral... I>
+      requires (sizeof...(I) != 0 && (sizeof...(I) == rank_dynamic() || sizeof...(I) == rank()))
+      constexpr explicit(sizeof...(I) != rank_dynamic()) extents(I... exts) noexcept
+         : extents(std::array<IndexType, sizeof...(I)>{ static_cast<IndexType>(exts)... }) {}
+
+      template <std::integral I, std::size_t N>
+      requires (N == rank_dynamic() || N == rank())
+      constexpr explicit(N != rank_dynamic()) extents(std::array<I, N> const& exts) noexcept {
+         std::size_t dynamic = 0;
+         for (rank_type r = 0; r < rank(); ++r) {
+            if constexpr (N == rank()) {
+               extents_[r] = static_cast<IndexType>(exts[r]);
+            }
+            else if (static_extents_[r] == dynamic_extent) {
+               extents_[r] = static_cast<IndexType>(exts[dynamic++]);
+            }
+         }
+      }
+
+      constexpr index_type extent(rank_type r) const noexcept {
+         return static_extents_[r] == dynamic_extent ? extents_[r] : static_cast<index_type>(static_extents_[r]);
+      }
+
+      template <class OtherIndexType, std::size_t... OtherExtents>
+      friend constexpr bool operator==(extents const& lhs, extents<OtherIndexType, OtherExtents...> const& rhs) noexcept {
+         if constexpr (sizeof...(OtherExtents) != rank()) {
+            return false;
+         }
+         else {
+            for (rank_type r = 0; r < rank(); ++r) {
+               if (static_cast<std::size_t>(lhs.extent(r)) != static_cast<std::size_t>(rhs.extent(r))) return false;
+            }
+            return true;
+         }
+      }
+   };
+
+   namespace detail {
+      template <std::size_t>
+      constexpr inline std::size_t always_dynamic = dynamic_extent;
+
+      template <class IndexType, class Seq>
+      struct dextents_for;
+      template <class IndexType, std::size_t... Is>
+      struct dextents_for<IndexType, std::index_sequence<Is...>> {
+         using type = extents<IndexType, always_dynamic<Is>...>;
+      };
+
+      template <class Extents>
+      constexpr typename Extents::index_type extents_product(Extents const& e, std::size_t first, std::size_t last) {
+         typename Extents::index_type product = 1;
+         for (auto r = first; r < last; ++r) product *= e.extent(r);
+         return product;
+      }
+   }
+
+   template <class IndexType, std::size_t Rank>
+   using dextents = typename detail::dextents_for<IndexType, std::make_index_sequence<Rank>>::type;
+
+   //Row-major: the last index is contiguous
+   struct layout_right {
+      template <class Extents>
+      class mapping {
+         Extents extents_{};
+
+      public:
+         using extents_type = Extents;
+         using index_type = typename Extents::index_type;
+         using rank_type = typename Extents::rank_type;
+         using layout_type = layout_right;
+
+         constexpr mapping() = default;
+         constexpr mapping(Extents const& e) noexcept : extents_(e) {}
+
+         constexpr Extents const& extents() const noexcept { return extents_; }
+
+         template <std::integral... I>
+         requires (sizeof...(I) == Extents::rank())
+         constexpr index_type operator()(I... idx) const noexcept {
+            index_type offset = 0;
+            [[maybe_unused]] rank_type r = 0;
+            ((offset = offset * extents_.extent(r++) + static_cast<index_type>(idx)), ...);
+            return offset;
+         }
+
+         constexpr index_type stride(rank_type r) const noexcept {
+            return detail::extents_product(extents_, r + 1, Extents::rank());
+         }
+         constexpr index_type required_span_size() const noexcept {
+            return detail::extents_product(extents_, 0, Extents::rank());
+         }
+
+         static constexpr bool is_always_unique() noexcept { return true; }
+         static constexpr bool is_always_exhaustive() noexcept { return true; }
+         static constexpr bool is_always_strided() noexcept { return true; }
+         static constexpr bool is_unique() noexcept { return true; }
+         static constexpr bool is_exhaustive() noexcept { return true; }
+         static constexpr bool is_strided() noexcept { return true; }
+
+         friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept {
+            return lhs.extents_ == rhs.extents_;
+         }
+      };
+   };
+
+   //Column-major: the first index is contiguous
+   struct layout_left {
+      template <class Extents>
+      class mapping {
+         Extents extents_{};
+
+      public:
+         using extents_type = Extents;
+         using index_type = typename Extents::index_type;
+         using rank_type = typename Extents::rank_type;
+         using layout_type = layout_left;
+
+         constexpr mapping() = default;
+         constexpr mapping(Extents const& e) noexcept : extents_(e) {}
+
+         constexpr Extents const& extents() const noexcept { return extents_; }
+
+         template <std::integral... I>
+         requires (sizeof...(I) == Extents::rank())
+         constexpr index_type operator()(I... idx) const noexcept {
+            std::array<index_type, sizeof...(I)> indices{ static_cast<index_type>(idx)... };
+            index_type offset = 0;
+            for (auto r = Extents::rank(); r-- > 0;) {
+               offset = offset * extents_.extent(r) + indices[r];
+            }
+            return offset;
+         }
+
+         constexpr index_type stride(rank_type r) const noexcept {
+            return detail::extents_product(extents_, 0, r);
+         }
+         constexpr index_type required_span_size() const noexcept {
+            return detail::extents_product(extents_, 0, Extents::rank());
+         }
+
+         static constexpr bool is_always_unique() noexcept { return true; }
+         static constexpr bool is_always_exhaustive() noexcept { return true; }
+         static constexpr bool is_always_strided() noexcept { return true; }
+         static constexpr bool is_unique() noexcept { return true; }
+         static constexpr bool is_exhaustive() noexcept { return true; }
+         static constexpr bool is_strided() noexcept { return true; }
+
+         friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept {
+            return lhs.extents_ == rhs.extents_;
+         }
+      };
+   };
+
+   //Arbitrary strides per dimension, e.g. a slice of another layout
+   struct layout_stride {
+      template <class Extents>
+      class mapping {
+      public:
+         using extents_type = Extents;
+         using index_type = typename Extents::index_type;
+         using rank_type = typename Extents::rank_type;
+         using layout_type = layout_stride;
+
+      private:
+         Extents extents_{};
+         std::array<index_type, Extents::rank()> strides_{};
+
+      public:
+         constexpr mapping() = default;
+         constexpr mapping(Extents const& e, std::array<index_type, Extents::rank()> const& strides) noexcept
+            : extents_(e), strides_(strides) {}
+
+         //From any other strided mapping with the same extents
+         template <class Other>
+         requires (!std::same_as<Other, mapping> && std::same_as<typename Other::extents_type, Extents> &&
+            Other::is_always_strided())
+         constexpr mapping(Other const& other) noexcept : extents_(other.extents()) {
+            for (rank_type r = 0; r < Extents::rank(); ++r) strides_[r] = other.stride(r);
+         }
+
+         constexpr Extents const& extents() const noexcept { return extents_; }
+         constexpr std::array<index_type, Extents::rank()> const& strides() const noexcept { return strides_; }
+
+         template <std::integral... I>
+         requires (sizeof...(I) == Extents::rank())
+         constexpr index_type operator()(I... idx) const noexcept {
+            index_type offset = 0;
+            [[maybe_unused]] rank_type r = 0;
+            ((offset += static_cast<index_type>(idx) * strides_[r++]), ...);
+            return offset;
+         }
+
+         constexpr index_type stride(rank_type r) const noexcept {
+            return strides_[r];
+         }
+         constexpr index_type required_span_size() const noexcept {
+            index_type size = 1;
+            for (rank_type r = 0; r < Extents::rank(); ++r) {
+               if (extents_.extent(r) == 0) return 0;
+               size += (extents_.extent(r) - 1) * strides_[r];
+            }
+            return size;
+         }
+
+         static constexpr bool is_always_unique() noexcept { return true; }
+         static constexpr bool is_always_exhaustive() noexcept { return false; }
+         static constexpr bool is_always_strided() noexcept { return true; }
+         static constexpr bool is_unique() noexcept { return true; }
+         constexpr bool is_exhaustive() const noexcept {
+            return required_span_size() == detail::extents_product(extents_, 0, Extents::rank());
+         }
+         static constexpr bool is_strided() noexcept { return true; }
+
+         friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept {
+            return lhs.extents_ == rhs.extents_ && lhs.strides_ == rhs.strides_;
+         }
+      };
+   };
+
+   template <class T, class Extents, class Layout = layout_right>
+   class mdspan {
+   public:
+      using extents_type = Extents;
+      using layout_type = Layout;
+      using mapping_type = typename Layout::template mapping<Extents>;
+      using element_type = T;
+      using value_type = std::remove_cv_t<T>;
+      using index_type = typename Extents::index_type;
+      using size_type = typename Extents::size_type;
+      using rank_type = typename Extents::rank_type;
+      using data_handle_type = T*;
+      using reference = T&;
+
+   private:
+      T* data_ = nullptr;
+      [[no_unique_address]] mapping_type map_{};
+
+   public:
+      constexpr mdspan() = default;
+
+      template <std::integral... I>
+      requires (sizeof...(I) != 0 && std::constructible_from<Extents, I...>)
+      constexpr explicit mdspan(T* data, I... exts)
+         : data_(data), map_(Extents(static_cast<index_type>(exts)...)) {}
+
+      constexpr mdspan(T* data, Extents const& e) : data_(data), map_(e) {}
+      constexpr mdspan(T* data, mapping_type const& m) : data_(data), map_(m) {}
+
+      //Converts e.g. const-qualifies the elements, or makes the layout strided
+      template <class U, class OtherLayout>
+      requires (std::convertible_to<U(*)[], T(*)[]> &&
+         std::constructible_from<mapping_type, typename OtherLayout::template mapping<Extents> const&>)
+      constexpr mdspan(mdspan<U, Extents, OtherLayout> const& other)
+         : data_(other.data_handle()), map_(other.mapping()) {}
+
+      template <std::integral... I>
+      requires (sizeof...(I) == Extents::rank())
+      constexpr reference operator()(I... idx) const {
+         return data_[map_(static_cast<index_type>(idx)...)];
+      }
+
+      template <std::integral I>
+      constexpr reference operator[](std::array<I, Extents::rank()> const& idx) const {
+         return std::apply([this](auto... i) -> reference { return (*this)(i...); }, idx);
+      }
+
+      static constexpr rank_type rank() noexcept { return Extents::rank(); }
+      static constexpr rank_type rank_dynamic() noexcept { return Extents::rank_dynamic(); }
+      static constexpr std::size_t static_extent(rank_type r) noexcept { return Extents::static_extent(r); }
+
+      constexpr index_type extent(rank_type r) const noexcept { return extents().extent(r); }
+      constexpr size_type size() const noexcept {
+         return static_cast<size_type>(detail::extents_product(extents(), 0, rank()));
+      }
+      constexpr bool empty() const noexcept { return size() == 0; }
+      constexpr index_type stride(rank_type r) const { return map_.stride(r); }
+
+      constexpr Extents const& extents() const noexcept { return map_.extents(); }
+      constexpr T* data_handle() const noexcept { return data_; }
+      constexpr mapping_type const& mapping() const noexcept { return map_; }
+
+      constexpr bool is_unique() const { return map_.is_unique(); }
+      constexpr bool is_exhaustive() const { return map_.is_exhaustive(); }
+      constexpr bool is_strided() const { return map_.is_strided(); }
+   };
+
+   template <class T, std::integral... I>
+   requires (sizeof...(I) != 0)
+   mdspan(T*, I...)->mdspan<T, dextents<std::size_t, sizeof...(I)>>;
+   template <class T, class IndexType, std::size_t... Extents>
+   mdspan(T*, extents<IndexType, Extents...> const&)->mdspan<T, extents<IndexType, Extents...>>;
+   template <class T, class Mapping>
+   requires requires { typename Mapping::layout_type; }
+   mdspan(T*, Mapping const&)->mdspan<T, typename Mapping::extents_type, typename Mapping::layout_type>;
+
+   //Views the elements of a contiguous range as an mdspan with the given extents
+   template <class Layout = layout_right, std::ranges::contiguous_range R, std::integral... I>
+   requires (std::ranges::borrowed_range<R> && sizeof...(I) != 0)
+   constexpr auto as_mdspan(R&& r, I... exts) {
+      using T = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+      using E = dextents<std::size_t, sizeof...(I)>;
+      return mdspan<T, E, Layout>(std::ranges::data(r), typename Layout::template mapping<E>(E(exts...)));
+   }
+
+   struct full_extent_t { explicit full_extent_t() = default; };
+   inline constexpr full_extent_t full_extent{};
+
+   namespace detail {
+      template <class S>
+      constexpr bool is_index_slice = std::integral<std::remove_cvref_t<S>>;
+
+      template <class S>
+      constexpr std::size_t slice_first(S const& s) {
+         if constexpr (std::same_as<S, full_extent_t>) return 0;
+         else if constexpr (is_index_slice<S>) return static_cast<std::size_t>(s);
+         else return static_cast<std::size_t>(std::get<0>(s));
+      }
+
+      template <class S>
+      constexpr std::size_t slice_last(S const& s, std::size_t extent) {
+         if constexpr (std::same_as<S, full_extent_t>) return extent;
+         else return static_cast<std::size_t>(std::get<1>(s));
+      }
+   }
+
+   template <class T, class Extents, class Layout, class... Slices>
+   requires (sizeof...(Slices) == Extents::rank() && Layout::template mapping<Extents>::is_always_strided())
+   constexpr auto submdspan(mdspan<T, Extents, Layout> const& m, Slices... slices) {
+      constexpr std::size_t rank = (!detail::is_index_slice<Slices> + ... + 0);
+      using index_type = typename Extents::index_type;
+      using E = dextents<index_type, rank>;
+
+      std::array<index_type, rank> exts{};
+      std::array<index_type, rank> strides{};
+      index_type offset = 0;
+      std::size_t r = 0, sub_r = 0;
+      auto add = [&](auto const& s) {
+         using S = std::remove_cvref_t<decltype(s)>;
+         auto first = static_cast<index_type>(detail::slice_first(s));
+         offset += first * m.stride(r);
+         if constexpr (!detail::is_index_slice<S>) {
+            exts[sub_r] = static_cast<index_type>(detail::slice_last(s, m.extent(r))) - first;
+            strides[sub_r] = m.stride(r);
+            ++sub_r;
+         }
+         ++r;
+      };
+      (add(slices), ...);
+
+      return mdspan<T, E, layout_stride>(m.data_handle() + offset, typename layout_stride::template mapping<E>(E(exts), strides));
+   }
+
+   namespace views {
+      namespace detail {
+         template <class M>
+         concept matrix = requires { typename M::mapping_type; } && M::rank() == 2 &&
+            M::mapping_type::is_always_strided();
+
+         struct rows_fn {
+            template <matrix M>
+            constexpr auto operator()(M const& m) const {
+               return std::views::iota(std::size_t(0), static_cast<std::size_t>(m.extent(0))) |
+                  std::views::transform([m](std::size_t i) {
+                     return strided_span(m.data_handle() + i * m.stride(0), static_cast<std::size_t>(m.extent(1)),
+                        static_cast<std::ptrdiff_t>(m.stride(1)));
+                  });
+            }
+         };
+
+         struct columns_fn {
+            template <matrix M>
+            constexpr auto operator()(M const& m) const {
+               return std::views::iota(std::size_t(0), static_cast<std::size_t>(m.extent(1))) |
+                  std::views::transform([m](std::size_t j) {
+                     return strided_span(m.data_handle() + j * m.stride(1), static_cast<std::size_t>(m.extent(0)),
+                        static_cast<std::ptrdiff_t>(m.stride(0)));
+                  });
+            }
+         };
+
+         struct tiles_fn_base {
+            template <matrix M>
+            constexpr auto operator()(M const& m, std::size_t height, std::size_t width) const {
+               auto rows = static_cast<std::size_t>(m.extent(0));
+               auto cols = static_cast<std::size_t>(m.extent(1));
+               auto tiles_across = (cols + width - 1) / width;
+               auto tiles_down = (rows + height - 1) / height;
+               return std::views::iota(std::size_t(0), tiles_across * tiles_down) |
+                  std::views::transform([=](std::size_t k) {
+                     auto top = k / tiles_across * height;
+                     auto left = k % tiles_across * width;
+                     return submdspan(m, std::pair(top, std::min(top + height, rows)),
+                        std::pair(left, std::min(left + width, cols)));
+                  });
+            }
+         };
+
+         struct tiles_fn : tiles_fn_base {
+            using tiles_fn_base::operator();
+
+            constexpr auto operator()(std::size_t height, std::size_t width) const {
+               return pipeable(bind_back(tiles_fn_base{}, height, width));
+            }
+         };
+      }
+
+      constexpr inline auto rows = pipeable(detail::rows_fn{});
+      constexpr inline auto columns = pipeable(detail::columns_fn{});
+      constexpr inline detail::tiles_fn tiles;
+   }
+}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef TL_RANGES_MERGE_HPP
+#define TL_RANGES_MERGE_HPP
+
+#include <ranges>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/semiregular_box.hpp"
+#include "utility/non_propagating_cache.hpp"
+#include "utility/loser_tree.hpp"
+
+//tl::views::merge(r1, r2, ...) lazily merges ranges which are each sorted, producing a single sorted range, e.g.
+//views::merge(std::vector{ 1, 4, 7 }, std::vector{ 2, 5 }, std::vector{ 3, 6 }) is { 1, 2, 3, 4, 5, 6, 7 }.
+//views::merge(comp, r1, r2, ...) merges ranges which are sorted by comp.
+//
+//tl::views::merge_dynamic(rs, comp) does the same for a range of sorted ranges, for when the number of runs is only
+//known at runtime, e.g. the outputs of each shard of some computation:
+//
+//auto all = shard_results | tl::views::merge_dynamic | tl::to<std::vector>();
+//
+//Both keep a tournament tree of the front elements, so each element costs ceil(log2(k)) comparisons for k ranges.
+//The merge is stable: equal elements come out in the order of the ranges they came from.
+//The result is a forward range if all of the ranges are, and is sized if they all are, so tl::to reserves up front.
+
+namespace tl {
+   namespace detail {
+      template <class Comp, class... Rs>
+      concept mergeable = requires {
+         typename std::common_reference_t<std::ranges::range_reference_t<Rs>...>;
+         typename std::common_type_t<std::ranges::range_value_t<Rs>...>;
+      } && std::strict_weak_order<Comp const&,
+         std::common_reference_t<std::ranges::range_reference_t<Rs>...>,
+         std::common_reference_t<std::ranges::range_reference_t<Rs>...>>;
+
+      //Whether the element from source a should come out before the one from source b, which don't compare equal.
+      //Ties go to the source with the lower index to keep the merge stable.
+      template <class Comp, class A, class B>
+      bool merge_before(Comp const& comp, std::size_t a, A&& a_value, std::size_t b, B&& b_value) {
+         if (a < b) return !std::invoke(comp, std::forward<B>(b_value), std::forward<A>(a_value));
+         return std::invoke(comp, std::forward<A>(a_value), std::forward<B>(b_value));
+      }
+   }
+
+   template <class Comp, std::ranges::input_range... Vs>
+   requires ((std::ranges::view<Vs> && ...) && (sizeof...(Vs) > 0) && std::is_object_v<Comp> &&
+      detail::mergeable<Comp, Vs...>)
+   class merge_view : public std::ranges::view_interface<merge_view<Comp, Vs...>> {
+      using reference = std::common_reference_t<std::ranges::range_reference_t<Vs>...>;
+      static constexpr std::size_t n_bases = sizeof...(Vs);
+
+      std::tuple<Vs...> bases_;
+      [[no_unique_address]] semiregular_storage_for<Comp> comp_;
+
+      class cursor {
+         merge_view* parent_ = nullptr;
+         std::tuple<std::ranges::iterator_t<Vs>...> current_;
+         detail::loser_tree<std::array<std::size_t, n_bases>> tree_;
+
+         template <std::size_t I>
+         static reference read_at(cursor const& c) {
+            return *std::get<I>(c.current_);
+         }
+         template <std::size_t I>
+         static bool done_at(cursor const& c) {
+            return std::get<I>(c.current_) == std::ranges::end(std::get<I>(c.parent_->bases_));
+         }
+         template <std::size_t I>
+         static void next_at(cursor& c) {
+            ++std::get<I>(c.current_);
+         }
+
+         //The iterators have different types, so go through a table to get at one by index
+         reference read(std::size_t i) const {
+            return[&]<std::size_t... Is>(std::index_sequence<Is...>) -> reference {
+               constexpr std::array<reference(*)(cursor const&), n_bases> table{ &read_at<Is>... };
+               return table[i](*this);
+            }(std::index_sequence_for<Vs...>{});
+         }
+         bool done(std::size_t i) const {
+            return[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+               constexpr std::array<bool(*)(cursor const&), n_bases> table{ &done_at<Is>... };
+               return table[i](*this);
+            }(std::index_sequence_for<Vs...>{});
+         }
+         void next(std::size_t i) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+               constexpr std::array<void(*)(cursor&), n_bases> table{ &next_at<Is>... };
+               table[i](*this);
+            }(std::index_sequence_for<Vs...>{});
+         }
+
+         auto beats() const {
+            return [this](std::size_t a, std::size_t b) {
+               if (done(a)) return false;
+               if (done(b)) return true;
+               return detail::merge_before(parent_->comp_, a, read(a), b, read(b));
+            };
+         }
+
+      public:
+         static constexpr bool single_pass = !(std::ranges::forward_range<Vs> && ...);
+
+         cursor() = default;
+         explicit cursor(merge_view* parent)
+            : parent_(parent), current_(std::apply([](auto&... bases) {
+               return std::tuple<std::ranges::iterator_t<Vs>...>(std::ranges::begin(bases)...);
+               }, parent->bases_)) {
+            tree_.build(beats());
+         }
+
+         reference read() const {
+            return read(tree_.winner());
+         }
+
+         void next() {
+            next(tree_.winner());
+            tree_.replay(beats());
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return done(tree_.winner());
+         }
+         bool equal(cursor const& rhs) const requires (std::equality_comparable<std::ranges::iterator_t<Vs>> && ...) {
+            return current_ == rhs.current_;
+         }
+      };
+
+   public:
+      merge_view() = default;
+      merge_view(Comp comp, Vs... bases) : bases_(std::move(bases)...), comp_(std::move(comp)) {}
+
+      auto begin() {
+         return basic_iterator{ cursor{ this } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      auto size() requires (std::ranges::sized_range<Vs> && ...) {
+         return std::apply([](auto&... bases) {
+            using size_type = std::make_unsigned_t<std::common_type_t<std::ranges::range_size_t<Vs>...>>;
+            return (static_cast<size_type>(std::ranges::size(bases)) + ...);
+            }, bases_);
+      }
+   };
+
+   template <class Comp, class... Rs>
+   merge_view(Comp, Rs&&...)->merge_view<Comp, std::views::all_t<Rs>...>;
+
+   //V is a range of sorted ranges. Its elements need to stay put while they're being merged, so V must be a forward range.
+   template <std::ranges::forward_range V, class Comp>
+   requires (std::ranges::view<V> && std::ranges::viewable_range<std::ranges::range_reference_t<V>> &&
+      std::ranges::input_range<std::ranges::range_reference_t<V>> && std::is_object_v<Comp> &&
+      std::indirect_strict_weak_order<Comp const,
+         std::ranges::iterator_t<std::views::all_t<std::ranges::range_reference_t<V>>>>)
+   class merge_dynamic_view : public std::ranges::view_interface<merge_dynamic_view<V, Comp>> {
+      using inner_view = std::views::all_t<std::ranges::range_reference_t<V>>;
+      using inner_iterator = std::ranges::iterator_t<inner_view>;
+
+      V base_;
+      [[no_unique_address]] semiregular_storage_for<Comp> comp_;
+      //The inner ranges, collected on the first call to begin
+      non_propagating_cache<std::vector<inner_view>> inners_;
+
+      std::vector<inner_view>& get_inners() {
+         if (!inners_) {
+            auto& inners = inners_.emplace();
+            for (auto&& inner : base_) {
+               inners.push_back(std::views::all(std::forward<decltype(inner)>(inner)));
+            }
+         }
+         return *inners_;
+      }
+
+      class cursor {
+         merge_dynamic_view* parent_ = nullptr;
+         std::vector<inner_iterator> current_;
+         detail::loser_tree<std::vector<std::size_t>> tree_;
+
+         bool done(std::size_t i) const {
+            return current_[i] == std::ranges::end((*parent_->inners_)[i]);
+         }
+
+         auto beats() const {
+            return [this](std::size_t a, std::size_t b) {
+               if (done(a)) return false;
+               if (done(b)) return true;
+               return detail::merge_before(parent_->comp_, a, *current_[a], b, *current_[b]);
+            };
+         }
+
+      public:
+         static constexpr bool single_pass = !std::ranges::forward_range<inner_view>;
+
+         cursor() = default;
+         explicit cursor(merge_dynamic_view* parent)
+            : parent_(parent), tree_(std::vector<std::size_t>(parent->get_inners().size())) {
+            current_.reserve(tree_.size());
+            for (auto& inner : *parent_->inners_) {
+               current_.push_back(std::ranges::begin(inner));
+            }
+            tree_.build(beats());
+         }
+
+         std::iter_reference_t<inner_iterator> read() const {
+            return *current_[tree_.winner()];
+         }
+
+         void next() {
+            ++current_[tree_.winner()];
+            tree_.replay(beats());
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return tree_.size() == 0 || done(tree_.winner());
+         }
+         bool equal(cursor const& rhs) const requires std::equality_comparable<inner_iterator> {
+            return current_ == rhs.current_;
+         }
+      };
+
+   public:
+      merge_dynamic_view() = default;
+      merge_dynamic_view(V base, Comp comp) : base_(std::move(base)), comp_(std::move(comp)) {}
+
+      auto begin() {
+         return basic_iterator{ cursor{ this } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      auto size() requires std::ranges::sized_range<inner_view> {
+         std::make_unsigned_t<std::ranges::range_size_t<inner_view>> size = 0;
+         for (auto& inner : get_inners()) {
+            size += std::ranges::size(inner);
+         }
+         return size;
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R, class Comp>
+   merge_dynamic_view(R&&, Comp)->merge_dynamic_view<std::views::all_t<R>, Comp>;
+
+   namespace views {
+      namespace detail {
+         struct merge_fn {
+            template <std::ranges::viewable_range... Rs>
+            requires ((std::ranges::input_range<Rs> && ...) && (sizeof...(Rs) > 0) &&
+               tl::detail::mergeable<std::ranges::less, Rs...>)
+            auto operator()(Rs&&... rs) const {
+               return merge_view(std::ranges::less{}, std::forward<Rs>(rs)...);
+            }
+            template <class Comp, std::ranges::viewable_range... Rs>
+            requires (!std::ranges::range<Comp> && (std::ranges::input_range<Rs> && ...) && (sizeof...(Rs) > 0) &&
+               tl::detail::mergeable<Comp, Rs...>)
+            auto operator()(Comp comp, Rs&&... rs) const {
+               return merge_view(std::move(comp), std::forward<Rs>(rs)...);
+            }
+         };
+
+         struct merge_dynamic_fn_base {
+            template <std::ranges::viewable_range R, class Comp = std::ranges::less>
+            requires (std::ranges::forward_range<R> && std::ranges::input_range<std::ranges::range_reference_t<R>>)
+            auto operator()(R&& r, Comp comp = {}) const {
+               return merge_dynamic_view(std::forward<R>(r), std::move(comp));
+            }
+         };
+
+         struct merge_dynamic_fn : merge_dynamic_fn_base {
+            using merge_dynamic_fn_base::operator();
+
+            template <class Comp>
+            requires (!std::ranges::range<Comp>)
+            auto operator()(Comp comp) const {
+               return pipeable(bind_back(merge_dynamic_fn_base{}, std::move(comp)));
+            }
+         };
+      }
+
+      constexpr inline detail::merge_fn merge;
+      constexpr inline auto merge_dynamic = pipeable(detail::merge_dynamic_fn{});
+   }
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef TL_RANGES_PAR_TRANSFORM_HPP
+#define TL_RANGES_PAR_TRANSFORM_HPP
+
+#include <ranges>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "common.hpp"
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/semiregular_box.hpp"
+#include "utility/non_propagating_cache.hpp"
+#include "utility/parallel.hpp"
+
+//tl::views::par_transform(f, window) is like std::views::transform(f), but evaluates f on a tl::thread_pool
+//for up to window elements ahead of the consumer. Results are yielded in the same order as the underlying range.
+//It's intended for expensive per-element work like parsing, compression or hashing, e.g.
+//
+//for (auto& hash : tl::views::getlines(file) | tl::views::par_transform(sha256, 64)) { ... }
+//
+//f is called concurrently from multiple threads, so it must be safe to do so.
+//Elements of forward ranges which are lvalue references are passed to f by reference, so the underlying range must not be
+//modified while the view is being iterated. Otherwise each element is copied as range_value_t before it's handed to the pool,
+//since e.g. getlines_view reuses the same string for every line.
+//
+//par_transform_view is an input range whose elements are the results of f, which are owned by the view.
+//If f throws, the exception is rethrown when the consumer reaches that element.
+//window defaults to twice the number of threads in the pool.
+//tl::views::par_transform(f, window, policy) runs on the pool given by a tl::parallel_policy instead of the default pool.
+
+namespace tl {
+   template <std::ranges::input_range V, std::copy_constructible F>
+   requires (std::ranges::view<V> && std::is_object_v<F>)
+   class par_transform_view : public std::ranges::view_interface<par_transform_view<V, F>> {
+      //Lvalues of forward ranges stay valid after the iterator moves on, so they can be passed to f by reference
+      static constexpr bool by_reference = std::ranges::forward_range<V> &&
+         std::is_lvalue_reference_v<std::ranges::range_reference_t<V>>;
+      using element_type = std::conditional_t<by_reference,
+         std::ranges::range_reference_t<V>, std::ranges::range_value_t<V>&>;
+      using result_type = std::remove_cvref_t<std::invoke_result_t<F const&, element_type>>;
+
+      //The results which are in flight, oldest first
+      struct state {
+         std::ranges::iterator_t<V> next_;
+         std::deque<std::future<result_type>> pending_;
+         non_propagating_cache<result_type> current_;
+
+         state(std::ranges::iterator_t<V> next) : next_(std::move(next)) {}
+         state(state&&) = default;
+
+         //Tasks refer to f and maybe the elements, so they need to finish before the view goes away
+         ~state() {
+            for (auto& p : pending_) {
+               if (p.valid()) p.wait();
+            }
+         }
+      };
+
+      V base_;
+      [[no_unique_address]] semiregular_storage_for<F> func_;
+      std::size_t window_ = 1;
+      thread_pool* pool_ = nullptr;
+      non_propagating_cache<state> state_;
+
+      void submit_next() {
+         auto& s = *state_;
+         auto const& f = func_;
+         if constexpr (by_reference) {
+            s.pending_.push_back(pool_->submit(
+               [&f, &element = *s.next_]() -> result_type { return std::invoke(f, element); }));
+         }
+         else {
+            s.pending_.push_back(pool_->submit(
+               [&f, element = std::ranges::range_value_t<V>(*s.next_)]() mutable -> result_type { return std::invoke(f, element); }));
+         }
+         ++s.next_;
+      }
+
+      void fill() {
+         while (state_->pending_.size() < window_ && state_->next_ != std::ranges::end(base_)) {
+            submit_next();
+         }
+      }
+
+      struct cursor {
+         par_transform_view* parent_ = nullptr;
+
+         static constexpr bool single_pass = true;
+
+         cursor() = default;
+         explicit cursor(par_transform_view* parent) : parent_(parent) {}
+
+         result_type& read() const {
+            auto& s = *parent_->state_;
+            if (!s.current_) {
+               parent_->pool_->wait(s.pending_.front());
+               s.current_.emplace(s.pending_.front().get());
+            }
+            return *s.current_;
+         }
+
+         void next() {
+            auto& s = *parent_->state_;
+            //Wait even if the result wasn't read, because the task may refer to the element
+            if (!s.current_) parent_->pool_->wait(s.pending_.front());
+            s.current_.reset();
+            s.pending_.pop_front();
+            parent_->fill();
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return parent_->state_->pending_.empty();
+         }
+         bool equal(cursor const& rhs) const {
+            return parent_ == rhs.parent_;
+         }
+      };
+
+   public:
+      par_transform_view() = default;
+      par_transform_view(V base, F f, std::size_t window, parallel_policy policy = {})
+         : base_(std::move(base)), func_(std::move(f)), window_(std::max<std::size_t>(window, 1)),
+         pool_(&detail::pool_for(policy)) {}
+      par_transform_view(V base, F f)
+         : par_transform_view(std::move(base), std::move(f), 2 * thread_pool::default_pool().size()) {}
+
+      auto begin() {
+         state_.emplace(std::ranges::begin(base_));
+         fill();
+         return basic_iterator{ cursor{ this } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      auto size() requires std::ranges::sized_range<V> {
+         return std::ranges::size(base_);
+      }
+      auto size() const requires std::ranges::sized_range<const V> {
+         return std::ranges::size(base_);
+      }
+
+      std::size_t window() const {
+         return window_;
+      }
+   };
+
+   template <class R, class F>
+   par_transform_view(R&&, F, std::size_t)->par_transform_view<std::views::all_t<R>, F>;
+   template <class R, class F>
+   par_transform_view(R&&, F, std::size_t, parallel_policy)->par_transform_view<std::views::all_t<R>, F>;
+   template <class R, class F>
+   par_transform_view(R&&, F)->par_transform_view<std::views::all_t<R>, F>;
+
+   namespace views {
+      namespace detail {
+         struct par_transform_fn_base {
+            template <std::ranges::viewable_range R, std::copy_constructible F>
+            auto operator()(R&& r, F f, std::size_t window, parallel_policy policy = {}) const
+               requires std::ranges::input_range<R> {
+               return par_transform_view(std::forward<R>(r), std::move(f), window, policy);
+            }
+            template <std::ranges::viewable_range R, std::copy_constructible F>
+            auto operator()(R&& r, F f) const
+               requires std::ranges::input_range<R> {
+               return par_transform_view(std::forward<R>(r), std::move(f));
+            }
+         };
+
+         struct par_transform_fn : par_transform_fn_base {
+            using par_transform_fn_base::operator();
+
+            template <std::copy_constructible F>
+            auto operator()(F f, std::size_t window, parallel_policy policy = {}) const {
+               return pipeable(bind_back(par_transform_fn_base{}, std::move(f), window, policy));
+            }
+            template <std::copy_constructible F>
+            auto operator()(F f) const {
+               return pipeable(bind_back(par_transform_fn_base{}, std::move(f)));
+            }
+         };
+      }
+
+      constexpr inline detail::par_transform_fn par_transform;
+   }
+}
+
+#endif
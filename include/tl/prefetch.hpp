@@ -0,0 +1,155 @@
+#ifndef TL_RANGES_PREFETCH_HPP
+#define TL_RANGES_PREFETCH_HPP
+
+#include <ranges>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/spsc_queue.hpp"
+
+//tl::views::prefetch(capacity) iterates the underlying range on a background thread, buffering up to capacity
+//elements ahead of the consumer, so that a slow source such as tl::views::getlines can overlap with the work being
+//done on its elements, e.g.
+//
+//for (auto& line : tl::views::getlines(file) | tl::views::prefetch(1024)) { process(line); }
+//
+//The worker thread starts on the call to begin() and takes ownership of the underlying range. Elements are copied or
+//moved into the buffer as range_value_t, and the result is an input range whose elements are those buffered values.
+//If iterating the underlying range throws, the exception is rethrown to the consumer once it reaches that point.
+//
+//Destroying the view before reaching the end stops the worker: it checks for a stop request before reading each element,
+//so at most it will finish the element it's currently producing. If the underlying range blocks indefinitely (e.g.
+//reading from a socket), so will the destructor. request_stop() makes the same request without waiting, after which the
+//view ends once it reaches the elements which were buffered by then.
+
+namespace tl {
+   template <std::ranges::input_range V>
+   requires (std::ranges::view<V> && std::movable<std::ranges::range_value_t<V>> &&
+      std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>)
+   class prefetch_view : public std::ranges::view_interface<prefetch_view<V>> {
+      using value_type = std::ranges::range_value_t<V>;
+
+      struct state {
+         V base_;
+         spsc_queue<value_type> queue_;
+         std::exception_ptr error_;
+         //Declared last so that the worker is joined before the rest of the state is destroyed
+         std::jthread worker_;
+
+         state(V base, std::size_t capacity)
+            : base_(std::move(base)), queue_(capacity), worker_([this](std::stop_token stop) { produce(stop); }) {}
+
+         ~state() {
+            //The stop request ends the worker while the queue has room; closing the queue wakes it if it's full
+            worker_.request_stop();
+            queue_.close();
+         }
+
+         void produce(std::stop_token stop) {
+            try {
+               //Check for a stop before reading each element, so no more of the underlying range is evaluated
+               auto end = std::ranges::end(base_);
+               for (auto it = std::ranges::begin(base_); it != end; ++it) {
+                  if (stop.stop_requested() || !queue_.push(*it)) break;
+               }
+            }
+            catch (...) {
+               error_ = std::current_exception();
+            }
+            queue_.finish();
+         }
+
+         //The current element, or nullptr if the end has been reached
+         value_type* peek() {
+            auto front = queue_.front();
+            if (!front && error_) std::rethrow_exception(error_);
+            return front;
+         }
+      };
+
+      V base_;
+      std::size_t capacity_ = 1;
+      std::unique_ptr<state> state_;
+
+      struct cursor {
+         state* state_ = nullptr;
+
+         static constexpr bool single_pass = true;
+
+         cursor() = default;
+         explicit cursor(state* s) : state_(s) {}
+
+         value_type& read() const {
+            return *state_->peek();
+         }
+
+         void next() {
+            state_->queue_.pop();
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return state_->peek() == nullptr;
+         }
+         bool equal(cursor const& rhs) const {
+            return state_ == rhs.state_;
+         }
+      };
+
+   public:
+      prefetch_view() = default;
+      prefetch_view(V base, std::size_t capacity)
+         : base_(std::move(base)), capacity_(capacity) {}
+
+      auto begin() {
+         state_ = std::make_unique<state>(std::move(base_), capacity_);
+         return basic_iterator{ cursor{ state_.get() } };
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+
+      std::size_t capacity() const {
+         return capacity_;
+      }
+
+      //Asks the worker to stop after the element it's currently producing, without waiting for it
+      void request_stop() {
+         if (state_) state_->worker_.request_stop();
+      }
+   };
+
+   template <class R>
+   prefetch_view(R&&, std::size_t)->prefetch_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct prefetch_fn_base {
+            template <std::ranges::viewable_range R>
+            auto operator()(R&& r, std::size_t capacity) const
+               requires (std::ranges::input_range<R> && std::movable<std::ranges::range_value_t<R>> &&
+                  std::constructible_from<std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>>) {
+               return prefetch_view(std::forward<R>(r), capacity);
+            }
+         };
+
+         struct prefetch_fn : prefetch_fn_base {
+            using prefetch_fn_base::operator();
+
+            auto operator()(std::size_t capacity) const {
+               return pipeable(bind_back(prefetch_fn_base{}, capacity));
+            }
+         };
+      }
+
+      constexpr inline detail::prefetch_fn prefetch;
+   }
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef TL_RANGES_RANDOM_HPP
+#define TL_RANGES_RANDOM_HPP
+
+#include <ranges>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <span>
+#include <type_traits>
+#include "basic_iterator.hpp"
+#include "utility/philox.hpp"
+
+//tl::views::random<Dist>(seed) is an unbounded random-access range of random numbers drawn from the distribution Dist,
+//and tl::views::random<Dist>(seed, n) is the first n of them, e.g.
+//
+//auto noise = tl::views::random<std::normal_distribution<float>>(42, 1'000'000) | tl::to<std::vector>();
+//auto dice = tl::views::random<std::uniform_int_distribution<int>>(seed, 100, std::uniform_int_distribution(1, 6));
+//
+//Unlike tl::views::generate over a std:: engine, element i only depends on the seed and i: it's drawn from stream i of
+//a tl::philox_engine, which is computed in O(1). So the range can be split across threads, e.g. with
+//tl::to<std::vector<float>>(tl::par, ...), read in any order or more than once, and always gives the same results.
+//
+//std::uniform_real_distribution and std::normal_distribution are computed directly from one Philox block per element,
+//without a loop, so that a block of elements can be generated with straight-line code which the compiler can vectorise.
+//The exact values for other distributions depend on the standard library, like the std:: distributions themselves.
+
+namespace tl {
+   namespace detail {
+      template <class T>
+      constexpr inline bool is_uniform_real = false;
+      template <class T>
+      constexpr inline bool is_uniform_real<std::uniform_real_distribution<T>> = true;
+
+      template <class T>
+      constexpr inline bool is_normal = false;
+      template <class T>
+      constexpr inline bool is_normal<std::normal_distribution<T>> = true;
+
+      //A uniform number in [0, 1) from two random words, with as many random bits as T's mantissa holds
+      template <std::floating_point T>
+      T unit_from_bits(std::uint32_t high, std::uint32_t low) {
+         if constexpr (sizeof(T) <= 4) {
+            return static_cast<T>(high >> 8) * T(0x1p-24);
+         }
+         else {
+            return static_cast<T>(((std::uint64_t(high) << 32) | low) >> 11) * T(0x1p-53);
+         }
+      }
+
+      //Element index of the range for the given seed
+      template <class Dist>
+      typename Dist::result_type random_element(Dist const& dist, philox4x32::key_type key, std::uint64_t index) {
+         using T = typename Dist::result_type;
+         if constexpr (is_uniform_real<Dist> || is_normal<Dist>) {
+            auto bits = philox4x32::generate(
+               { static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32), 0, 0 }, key);
+            if constexpr (is_uniform_real<Dist>) {
+               return dist.a() + (dist.b() - dist.a()) * unit_from_bits<T>(bits[0], bits[1]);
+            }
+            else {
+               //Box-Muller. 1 - u is in (0, 1], so the log is finite.
+               auto radius = std::sqrt(T(-2) * std::log(T(1) - unit_from_bits<T>(bits[0], bits[1])));
+               auto angle = T(2) * std::numbers::pi_v<T> * unit_from_bits<T>(bits[2], bits[3]);
+               return dist.mean() + dist.stddev() * radius * std::cos(angle);
+            }
+         }
+         else {
+            Dist d = dist;
+            philox_engine engine(key, index);
+            return d(engine);
+         }
+      }
+   }
+
+   template <class Dist, class Bound = std::unreachable_sentinel_t>
+   requires (std::copy_constructible<Dist> && std::invocable<Dist&, philox_engine&> &&
+      (std::same_as<Bound, std::unreachable_sentinel_t> || std::same_as<Bound, std::size_t>))
+   class random_view : public std::ranges::view_interface<random_view<Dist, Bound>> {
+      using value_type = typename Dist::result_type;
+      static constexpr bool sized = std::same_as<Bound, std::size_t>;
+
+      Dist dist_;
+      philox4x32::key_type key_{};
+      Bound bound_{};
+
+      class cursor {
+         random_view const* parent_ = nullptr;
+         std::uint64_t index_ = 0;
+
+      public:
+         cursor() = default;
+         cursor(random_view const* parent, std::uint64_t index) : parent_(parent), index_(index) {}
+
+         value_type read() const {
+            return detail::random_element(parent_->dist_, parent_->key_, index_);
+         }
+
+         void next() {
+            ++index_;
+         }
+         void prev() {
+            --index_;
+         }
+         void advance(std::ptrdiff_t n) {
+            index_ += static_cast<std::uint64_t>(n);
+         }
+
+         bool equal(cursor const& rhs) const {
+            return index_ == rhs.index_;
+         }
+         std::ptrdiff_t distance_to(cursor const& rhs) const {
+            return static_cast<std::ptrdiff_t>(rhs.index_ - index_);
+         }
+      };
+
+   public:
+      random_view() = default;
+      random_view(std::uint64_t seed, Bound bound, Dist dist = Dist())
+         : dist_(std::move(dist)), key_(philox4x32::key_for(seed)), bound_(bound) {}
+
+      auto begin() const {
+         return basic_iterator{ cursor{ this, 0 } };
+      }
+
+      auto end() const {
+         if constexpr (sized) {
+            return basic_iterator{ cursor{ this, bound_ } };
+         }
+         else {
+            return std::unreachable_sentinel;
+         }
+      }
+
+      std::size_t size() const requires sized {
+         return bound_;
+      }
+
+      //Writes the first out.size() elements to out. Used by tl::to.
+      void copy_to(std::span<value_type> out) const requires sized {
+         auto n = std::min(out.size(), bound_);
+         for (std::size_t i = 0; i < n; ++i) {
+            out[i] = detail::random_element(dist_, key_, i);
+         }
+      }
+   };
+
+   namespace views {
+      namespace detail {
+         template <class Dist>
+         struct random_fn {
+            auto operator()(std::uint64_t seed, Dist dist = Dist()) const {
+               return random_view<Dist>(seed, std::unreachable_sentinel, std::move(dist));
+            }
+            auto operator()(std::uint64_t seed, std::size_t n, Dist dist = Dist()) const {
+               return random_view<Dist, std::size_t>(seed, n, std::move(dist));
+            }
+         };
+      }
+
+      template <class Dist>
+      constexpr inline detail::random_fn<Dist> random;
+   }
+}
+
+#endif
@@ -62,6 +62,10 @@ namespace tl {
       constexpr auto end() const {
          return std::unreachable_sentinel;
       }
+
+      constexpr T const& value() const {
+         return value_.value();
+      }
    };
 
    template <class T>
@@ -71,6 +71,14 @@ namespace tl {
       constexpr auto end() const {
          return std::default_sentinel;
       }
+
+      constexpr T const& value() const {
+         return value_.value();
+      }
+
+      constexpr std::size_t size() const {
+         return n_;
+      }
    };
 
    template <class T>
@@ -0,0 +1,110 @@
+#ifndef TL_RANGES_RLE_HPP
+#define TL_RANGES_RLE_HPP
+
+#include <ranges>
+#include <iterator>
+#include <functional>
+#include <utility>
+#include "common.hpp"
+#include "basic_iterator.hpp"
+#include "utility/non_propagating_cache.hpp"
+#include "utility/adjacent_mismatch.hpp"
+#include "functional/pipeable.hpp"
+
+//tl::views::rle run-length encodes a range, producing (value, count) pairs for each run of equal elements.
+//e.g. {1, 1, 2, 3, 3, 3} | tl::views::rle is {(1,2), (2,1), (3,3)}
+
+namespace tl {
+   template <std::ranges::forward_range V>
+   requires (std::ranges::view<V> && std::equality_comparable<std::ranges::range_reference_t<V>> &&
+      std::constructible_from<std::ranges::range_value_t<V>, std::ranges::range_reference_t<V>>)
+   class rle_view
+      : public std::ranges::view_interface<rle_view<V>> {
+   private:
+      V base_;
+      [[no_unique_address]] std::ranges::equal_to equal_;
+      //Need to cache the end of the first run so that begin is amortized O(1)
+      non_propagating_cache<std::ranges::iterator_t<V>> end_of_first_run_;
+
+      //Runs are found with the same search as chunk_by_view, so contiguous arithmetic ranges are vectorised
+      constexpr std::ranges::iterator_t<V> find_end_of_run(std::ranges::iterator_t<V> it) {
+         auto first_failed = detail::find_adjacent_mismatch(std::move(it), std::ranges::end(base_), equal_);
+         return std::ranges::next(first_failed, 1, std::ranges::end(base_));
+      }
+
+      constexpr auto get_end_of_first_run() {
+         if (!end_of_first_run_) {
+            end_of_first_run_ = find_end_of_run(std::ranges::begin(base_));
+         }
+         return *end_of_first_run_;
+      }
+
+      struct sentinel {
+         std::ranges::sentinel_t<V> end_;
+         sentinel() = default;
+         constexpr sentinel(std::ranges::sentinel_t<V> end) : end_(std::move(end)) {}
+      };
+
+      struct cursor {
+         std::ranges::iterator_t<V> current_;
+         std::ranges::iterator_t<V> end_of_current_run_;
+         rle_view* parent_;
+
+         cursor() = default;
+         constexpr cursor(std::ranges::iterator_t<V> begin, std::ranges::iterator_t<V> end_of_first_run, rle_view* parent)
+            : current_(std::move(begin)), end_of_current_run_(std::move(end_of_first_run)), parent_(parent) {
+         }
+
+         constexpr auto read() const {
+            return std::pair<std::ranges::range_value_t<V>, std::ranges::range_difference_t<V>>(
+               *current_, std::ranges::distance(current_, end_of_current_run_));
+         }
+
+         constexpr void next() {
+            current_ = std::exchange(end_of_current_run_, parent_->find_end_of_run(end_of_current_run_));
+         }
+
+         constexpr bool equal(cursor const& rhs) const {
+            return current_ == rhs.current_;
+         }
+         constexpr bool equal(sentinel const& rhs) const {
+            return current_ == rhs.end_;
+         }
+      };
+
+   public:
+      rle_view() = default;
+      rle_view(V v) : base_(std::move(v)) {}
+
+      constexpr auto begin() {
+         return basic_iterator{ cursor{ std::ranges::begin(base_), get_end_of_first_run(), this } };
+      }
+
+      constexpr auto end() {
+         return sentinel{ std::ranges::end(base_) };
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R>
+   rle_view(R&&)->rle_view<std::views::all_t<R>>;
+
+   namespace views {
+      namespace detail {
+         struct rle_fn {
+            template <std::ranges::viewable_range R>
+            constexpr auto operator()(R&& r) const
+               requires (std::ranges::forward_range<R> && std::equality_comparable<std::ranges::range_reference_t<R>>) {
+               return rle_view(std::forward<R>(r));
+            }
+         };
+      }
+
+      constexpr inline auto rle = pipeable(detail::rle_fn{});
+   }
+}
+
+#endif
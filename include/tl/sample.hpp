@@ -0,0 +1,66 @@
+#ifndef TL_RANGES_SAMPLE_HPP
+#define TL_RANGES_SAMPLE_HPP
+
+#include <ranges>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+//tl::sample(r, k, rng) picks k elements of r uniformly at random in a single pass, without knowing the size of r up front.
+//It returns them in a vector, in no particular order. If r has fewer than k elements, all of them are returned.
+//
+//This is Algorithm L (Li, 1994): rather than drawing a random number for every element like std::sample does for input
+//ranges, it draws how many elements to skip before the next one which goes into the reservoir. So it makes
+//O(k(1 + log(n/k))) calls to rng, and skipped elements are stepped over with std::ranges::advance without being read,
+//which is O(1) for sized random-access ranges.
+//
+//For a stream which never ends, see tl::views::bernoulli instead.
+
+namespace tl {
+   namespace detail {
+      //A uniform double in (0, 1), since the algorithm takes logs of it
+      template <class URBG>
+      double open_unit(URBG& rng) {
+         return std::uniform_real_distribution<double>(std::numeric_limits<double>::min(), 1.0)(rng);
+      }
+   }
+
+   template <std::ranges::input_range R, class URBG>
+   requires (std::uniform_random_bit_generator<std::remove_reference_t<URBG>> &&
+      std::constructible_from<std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>> &&
+      std::movable<std::ranges::range_value_t<R>>)
+   std::vector<std::ranges::range_value_t<R>> sample(R&& r, std::size_t k, URBG&& rng) {
+      using difference_type = std::ranges::range_difference_t<R>;
+      std::vector<std::ranges::range_value_t<R>> reservoir;
+      if (k == 0) return reservoir;
+      reservoir.reserve(k);
+
+      auto it = std::ranges::begin(r);
+      auto last = std::ranges::end(r);
+      for (; it != last && reservoir.size() < k; ++it) {
+         reservoir.emplace_back(*it);
+      }
+
+      std::uniform_int_distribution<std::size_t> slot(0, k - 1);
+      auto w = std::exp(std::log(detail::open_unit(rng)) / static_cast<double>(k));
+      while (it != last) {
+         //The number of elements to pass over is geometrically distributed with parameter w
+         auto skip = std::floor(std::log(detail::open_unit(rng)) / std::log1p(-w));
+         constexpr auto max_skip = static_cast<double>(std::numeric_limits<difference_type>::max() / 2);
+         if (std::ranges::advance(it, static_cast<difference_type>(std::min(skip, max_skip)), last) != 0 || it == last) break;
+
+         reservoir[slot(rng)] = std::ranges::range_value_t<R>(*it);
+         ++it;
+         w *= std::exp(std::log(detail::open_unit(rng)) / static_cast<double>(k));
+      }
+      return reservoir;
+   }
+}
+
+#endif
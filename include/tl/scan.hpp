@@ -0,0 +1,102 @@
+#ifndef TL_RANGES_SCAN_HPP
+#define TL_RANGES_SCAN_HPP
+
+#include <ranges>
+#include <iterator>
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "utility/parallel.hpp"
+
+//tl::inclusive_scan(r, out, f) writes the running fold of r with f to out, i.e. r[0], f(r[0], r[1]), f(f(r[0], r[1]), r[2])...
+//and returns the end of the output. It's the eager counterpart of tl::views::partial_sum.
+//
+//tl::inclusive_scan(tl::par, r, out, f) does the same on the policy's pool in two parallel passes: one to fold each
+//block, and one to scan each block starting from the combined results of the blocks before it. This calls f roughly
+//twice as many times as the serial version, and f must be associative.
+
+namespace tl {
+   namespace detail {
+      template <class R, class O, class F>
+      concept scannable = std::ranges::input_range<R> &&
+         std::constructible_from<std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>> &&
+         std::invocable<F&, std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>> &&
+         std::assignable_from<std::ranges::range_value_t<R>&,
+            std::invoke_result_t<F&, std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>>> &&
+         std::indirectly_writable<O, std::ranges::range_value_t<R> const&>;
+
+      //Scans [first, last) into out, starting from carry if there is one
+      template <class T, class I, class S, class O, class F>
+      O inclusive_scan_from(std::optional<T> carry, I first, S last, O out, F& f) {
+         if (first == last) return out;
+         if (carry) {
+            *carry = std::invoke(f, std::move(*carry), *first);
+         }
+         else {
+            carry.emplace(*first);
+         }
+         *out = *carry;
+         ++out;
+         for (++first; first != last; ++first, ++out) {
+            *carry = std::invoke(f, std::move(*carry), *first);
+            *out = *carry;
+         }
+         return out;
+      }
+   }
+
+   template <std::ranges::input_range R, std::weakly_incrementable O, class F = std::plus<>>
+   requires detail::scannable<R, O, F>
+   O inclusive_scan(R&& r, O out, F f = {}) {
+      return detail::inclusive_scan_from(std::optional<std::ranges::range_value_t<R>>(),
+         std::ranges::begin(r), std::ranges::end(r), std::move(out), f);
+   }
+
+   template <std::ranges::random_access_range R, std::random_access_iterator O, std::copy_constructible F = std::plus<>>
+   requires (std::ranges::sized_range<R> && detail::scannable<R, O, F> &&
+      std::invocable<F&, std::ranges::range_value_t<R>, std::ranges::range_value_t<R>&>)
+   O inclusive_scan(parallel_policy policy, R&& r, O out, F f = {}) {
+      using T = std::ranges::range_value_t<R>;
+      using difference_type = std::ranges::range_difference_t<R>;
+      constexpr std::size_t min_block = 1 << 12;
+
+      auto n = static_cast<std::size_t>(std::ranges::distance(r));
+      auto blocks = detail::block_count(policy, n, min_block);
+      if (blocks <= 1) return tl::inclusive_scan(r, std::move(out), std::move(f));
+
+      auto begin = std::ranges::begin(r);
+      auto block_range = [&](std::size_t first, std::size_t last) {
+         return std::ranges::subrange(begin + static_cast<difference_type>(first), begin + static_cast<difference_type>(last));
+      };
+
+      //Fold every block but the last
+      std::vector<std::optional<T>> carries(blocks);
+      detail::parallel_for_blocks(policy, blocks, n, [&](std::size_t block, std::size_t first, std::size_t last) {
+         if (block + 1 == blocks) return;
+         auto block_f = f;
+         auto sub = block_range(first, last);
+         auto it = sub.begin();
+         T accum(*it);
+         for (++it; it != sub.end(); ++it) {
+            accum = std::invoke(block_f, std::move(accum), *it);
+         }
+         carries[block + 1].emplace(std::move(accum));
+      });
+
+      //Each block starts from the combination of all of the blocks before it
+      for (std::size_t block = 2; block < blocks; ++block) {
+         carries[block] = std::invoke(f, T(*carries[block - 1]), *carries[block]);
+      }
+
+      detail::parallel_for_blocks(policy, blocks, n, [&](std::size_t block, std::size_t first, std::size_t last) {
+         auto block_f = f;
+         auto sub = block_range(first, last);
+         detail::inclusive_scan_from(std::move(carries[block]), sub.begin(), sub.end(),
+            out + static_cast<std::iter_difference_t<O>>(first), block_f);
+      });
+      return out + static_cast<std::iter_difference_t<O>>(n);
+   }
+}
+
+#endif
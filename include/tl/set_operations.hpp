@@ -0,0 +1,265 @@
+#ifndef TL_RANGES_SET_OPERATIONS_HPP
+#define TL_RANGES_SET_OPERATIONS_HPP
+
+#include <ranges>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/semiregular_box.hpp"
+#include "utility/non_propagating_cache.hpp"
+
+//Lazy versions of the standard algorithms on sorted ranges:
+//tl::views::set_union(a, b), tl::views::set_intersection(a, b), tl::views::set_difference(a, b) and
+//tl::views::set_symmetric_difference(a, b), all of which take an optional comparator and can be piped, e.g.
+//
+//auto docs = posting_list_a | tl::views::set_intersection(posting_list_b);
+//
+//They produce the same elements as the std:: algorithms of the same names, including for duplicates: an element which
+//appears m times in a and n times in b appears max(m, n) times in the union, min(m, n) in the intersection, and so on.
+//Elements which are in both ranges are taken from a.
+//
+//When one range gets ahead of the other, the elements of the other which are skipped over are found with a galloping
+//search if it's random access and sized, so intersecting a short range with a long one costs O(m log(n/m))
+//comparisons rather than O(m + n). Runs of one element cost the same as a linear scan.
+
+namespace tl {
+   enum class set_operation {
+      union_,
+      intersection,
+      difference,
+      symmetric_difference
+   };
+
+   namespace detail {
+      template <set_operation Op, class V1, class V2>
+      struct set_operation_reference {
+         using type = std::ranges::range_reference_t<V1>;
+      };
+      template <set_operation Op, class V1, class V2>
+      requires (Op == set_operation::union_ || Op == set_operation::symmetric_difference)
+      struct set_operation_reference<Op, V1, V2> {
+         using type = std::common_reference_t<std::ranges::range_reference_t<V1>, std::ranges::range_reference_t<V2>>;
+      };
+
+      template <set_operation Op, class V1, class V2>
+      concept set_operation_readable = (Op == set_operation::intersection || Op == set_operation::difference) || requires {
+         typename std::common_reference_t<std::ranges::range_reference_t<V1>, std::ranges::range_reference_t<V2>>;
+         typename std::common_type_t<std::ranges::range_value_t<V1>, std::ranges::range_value_t<V2>>;
+      };
+
+      //Given that comp(*first, value), returns the first iterator in (first, last) which isn't less than value
+      template <class I, class S, class T, class Comp>
+      I skip_less(I first, S last, T const& value, Comp const& comp) {
+         if constexpr (std::random_access_iterator<I> && std::sized_sentinel_for<S, I>) {
+            //Gallop forwards to find an interval which contains the answer, then binary search it
+            auto size = last - first;
+            std::iter_difference_t<I> step = 1;
+            auto less_than_value = first;
+            while (step < size && std::invoke(comp, *(first + step), value)) {
+               less_than_value = first + step;
+               step *= 2;
+            }
+            return std::ranges::lower_bound(less_than_value + 1, first + std::min(step, size), value, std::ref(comp));
+         }
+         else {
+            do {
+               ++first;
+            } while (first != last && std::invoke(comp, *first, value));
+            return first;
+         }
+      }
+   }
+
+   template <set_operation Op, std::ranges::input_range V1, std::ranges::input_range V2, class Comp>
+   requires (std::ranges::view<V1> && std::ranges::view<V2> && std::is_object_v<Comp> &&
+      std::indirect_strict_weak_order<Comp const, std::ranges::iterator_t<V1>, std::ranges::iterator_t<V2>> &&
+      detail::set_operation_readable<Op, V1, V2>)
+   class set_operation_view : public std::ranges::view_interface<set_operation_view<Op, V1, V2, Comp>> {
+      using reference = typename detail::set_operation_reference<Op, V1, V2>::type;
+
+      V1 first_base_;
+      V2 second_base_;
+      [[no_unique_address]] semiregular_storage_for<Comp> comp_;
+
+      //Which of the ranges the current element comes from, and which to advance past it
+      enum class source {
+         first,
+         second,
+         both
+      };
+
+      class cursor {
+         set_operation_view* parent_ = nullptr;
+         std::ranges::iterator_t<V1> first_;
+         std::ranges::iterator_t<V2> second_;
+         source current_ = source::first;
+
+         bool first_done() const {
+            return first_ == std::ranges::end(parent_->first_base_);
+         }
+         bool second_done() const {
+            return second_ == std::ranges::end(parent_->second_base_);
+         }
+         bool first_less() const {
+            return std::invoke(parent_->comp_, *first_, *second_);
+         }
+         bool second_less() const {
+            return std::invoke(parent_->comp_, *second_, *first_);
+         }
+         void skip_first() {
+            first_ = detail::skip_less(std::move(first_), std::ranges::end(parent_->first_base_), *second_, parent_->comp_);
+         }
+         void skip_second() {
+            second_ = detail::skip_less(std::move(second_), std::ranges::end(parent_->second_base_), *first_, parent_->comp_);
+         }
+
+         //Moves to the next element of the result
+         void satisfy() {
+            if constexpr (Op == set_operation::union_) {
+               if (first_done()) current_ = source::second;
+               else if (second_done()) current_ = source::first;
+               else if (first_less()) current_ = source::first;
+               else if (second_less()) current_ = source::second;
+               else current_ = source::both;
+            }
+            else if constexpr (Op == set_operation::intersection) {
+               while (!first_done() && !second_done()) {
+                  if (first_less()) skip_first();
+                  else if (second_less()) skip_second();
+                  else {
+                     current_ = source::both;
+                     return;
+                  }
+               }
+            }
+            else if constexpr (Op == set_operation::difference) {
+               current_ = source::first;
+               while (!first_done() && !second_done()) {
+                  if (first_less()) return;
+                  if (second_less()) skip_second();
+                  else {
+                     ++first_;
+                     ++second_;
+                  }
+               }
+            }
+            else {
+               while (!first_done() && !second_done()) {
+                  if (first_less()) {
+                     current_ = source::first;
+                     return;
+                  }
+                  if (second_less()) {
+                     current_ = source::second;
+                     return;
+                  }
+                  ++first_;
+                  ++second_;
+               }
+               current_ = first_done() ? source::second : source::first;
+            }
+         }
+
+      public:
+         static constexpr bool single_pass = !(std::ranges::forward_range<V1> && std::ranges::forward_range<V2>);
+
+         cursor() = default;
+         explicit cursor(set_operation_view* parent)
+            : parent_(parent), first_(std::ranges::begin(parent->first_base_)),
+            second_(std::ranges::begin(parent->second_base_)) {
+            satisfy();
+         }
+
+         reference read() const {
+            if constexpr (Op == set_operation::union_ || Op == set_operation::symmetric_difference) {
+               if (current_ == source::second) return *second_;
+            }
+            return *first_;
+         }
+
+         void next() {
+            if (current_ != source::second) ++first_;
+            if (current_ != source::first) ++second_;
+            satisfy();
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            if constexpr (Op == set_operation::intersection) {
+               return first_done() || second_done();
+            }
+            else if constexpr (Op == set_operation::difference) {
+               return first_done();
+            }
+            else {
+               return first_done() && second_done();
+            }
+         }
+         bool equal(cursor const& rhs) const
+            requires (std::equality_comparable<std::ranges::iterator_t<V1>> && std::equality_comparable<std::ranges::iterator_t<V2>>) {
+            return first_ == rhs.first_ && second_ == rhs.second_;
+         }
+      };
+
+      //Finding the first element can skip over a lot, so cache it for forward ranges
+      static constexpr bool cache_begin = std::ranges::forward_range<V1> && std::ranges::forward_range<V2>;
+      [[no_unique_address]] std::conditional_t<cache_begin, non_propagating_cache<cursor>, std::nullptr_t> begin_{};
+
+   public:
+      set_operation_view() = default;
+      set_operation_view(V1 first, V2 second, Comp comp)
+         : first_base_(std::move(first)), second_base_(std::move(second)), comp_(std::move(comp)) {}
+
+      auto begin() {
+         if constexpr (cache_begin) {
+            if (!begin_) begin_.emplace(this);
+            return basic_iterator{ *begin_ };
+         }
+         else {
+            return basic_iterator{ cursor{ this } };
+         }
+      }
+
+      auto end() const noexcept {
+         return std::default_sentinel;
+      }
+   };
+
+   namespace views {
+      namespace detail {
+         template <set_operation Op>
+         struct set_operation_fn_base {
+            template <std::ranges::viewable_range R1, std::ranges::viewable_range R2, class Comp = std::ranges::less>
+            requires (std::ranges::input_range<R1> && std::ranges::input_range<R2> &&
+               std::indirect_strict_weak_order<Comp const, std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>>)
+            auto operator()(R1&& r1, R2&& r2, Comp comp = {}) const {
+               return set_operation_view<Op, std::views::all_t<R1>, std::views::all_t<R2>, Comp>(
+                  std::views::all(std::forward<R1>(r1)), std::views::all(std::forward<R2>(r2)), std::move(comp));
+            }
+         };
+
+         template <set_operation Op>
+         struct set_operation_fn : set_operation_fn_base<Op> {
+            using set_operation_fn_base<Op>::operator();
+
+            template <std::ranges::viewable_range R2, class Comp = std::ranges::less>
+            requires (std::ranges::input_range<R2> && !std::ranges::range<Comp>)
+            auto operator()(R2&& r2, Comp comp = {}) const {
+               return pipeable(bind_back(set_operation_fn_base<Op>{}, std::views::all(std::forward<R2>(r2)), std::move(comp)));
+            }
+         };
+      }
+
+      constexpr inline detail::set_operation_fn<set_operation::union_> set_union;
+      constexpr inline detail::set_operation_fn<set_operation::intersection> set_intersection;
+      constexpr inline detail::set_operation_fn<set_operation::difference> set_difference;
+      constexpr inline detail::set_operation_fn<set_operation::symmetric_difference> set_symmetric_difference;
+   }
+}
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef TL_RANGES_SINK_HPP
+#define TL_RANGES_SINK_HPP
+
+//Sinks are destinations for the elements of a range which take them a block at a time: a sink for T has
+//s.put(std::span<T const>). tl::copy(r, s), or r | tl::copy(s), writes a range to a sink with as few calls to put as
+//it can: contiguous ranges are passed in one block, and other ranges are staged in blocks on the stack. tl::to(r, s)
+//and r | tl::to(s) are the same thing. The sinks are:
+//
+//tl::sink::append(c)           Appends to a container with c.insert(c.end(), first, last), a block at a time.
+//tl::sink::ostream(os[, sep])  Buffers text and writes it to os in large chunks. Characters are written as they are;
+//                              numbers are formatted with std::to_chars and strings are copied, each followed by sep.
+//tl::sink::file(fd)            Buffers the bytes of trivially copyable elements and writes them to a file descriptor,
+//                              so many small puts become a few large write calls. Blocks bigger than the buffer are
+//                              written directly. Write errors, and negative descriptors, are thrown as
+//                              std::system_error.
+//tl::sink::partition(n, key)   Appends each element x to bucket key(x) % n, e.g. to split a range for hashing or
+//                              sorting in parallel. buckets() gives the n vectors.
+//
+//The ostream and file sinks write whatever is buffered when they are destroyed, or when flush() is called.
+//
+//auto out = tl::sink::file(fd);
+//records | std::views::transform(encode) | tl::copy(out);
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "functional/pipeable.hpp"
+#include "functional/bind.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace tl {
+   template <class S, class T>
+   concept sink_for = requires(S & s, std::span<T const> block) {
+      s.put(block);
+   };
+
+   namespace sink {
+      template <class C>
+      class append_sink {
+         C* c_;
+
+      public:
+         explicit append_sink(C& c) : c_(std::addressof(c)) {}
+
+         void put(std::span<typename C::value_type const> block) {
+            c_->insert(c_->end(), block.begin(), block.end());
+         }
+      };
+
+      template <class C>
+      append_sink<C> append(C& c) {
+         return append_sink<C>(c);
+      }
+
+      class ostream_sink {
+         static constexpr std::size_t capacity = 1 << 13;
+
+         std::ostream* os_;
+         std::string separator_;
+         std::string buffer_;
+
+         void flush_if_full() {
+            if (buffer_.size() >= capacity) flush();
+         }
+
+      public:
+         explicit ostream_sink(std::ostream& os, std::string_view separator = "\n")
+            : os_(std::addressof(os)), separator_(separator) {
+            buffer_.reserve(capacity + 64);
+         }
+
+         ostream_sink(ostream_sink const&) = delete;
+         ostream_sink& operator=(ostream_sink const&) = delete;
+         ostream_sink(ostream_sink&& other) noexcept
+            : os_(std::exchange(other.os_, nullptr)), separator_(std::move(other.separator_)), buffer_(std::move(other.buffer_)) {}
+
+         ~ostream_sink() {
+            try {
+               flush();
+            }
+            catch (...) {
+               //Streams with exceptions enabled throw whatever their buffer does. Call flush() first to see errors.
+            }
+         }
+
+         template <class T>
+         void put(std::span<T const> block) {
+            if constexpr (std::same_as<T, char>) {
+               buffer_.append(block.data(), block.size());
+               flush_if_full();
+            }
+            else if constexpr (std::is_arithmetic_v<T> && !std::same_as<T, bool>) {
+               //Longer than the shortest representation of any integer or floating point value
+               constexpr std::size_t max_length = 64;
+               for (auto const& x : block) {
+                  auto size = buffer_.size();
+                  buffer_.resize(size + max_length);
+                  auto result = std::to_chars(buffer_.data() + size, buffer_.data() + buffer_.size(), x);
+                  buffer_.resize(static_cast<std::size_t>(result.ptr - buffer_.data()));
+                  buffer_ += separator_;
+                  flush_if_full();
+               }
+            }
+            else {
+               static_assert(std::convertible_to<T const&, std::string_view>, "ostream_sink writes characters, numbers and strings");
+               for (auto const& x : block) {
+                  buffer_ += std::string_view(x);
+                  buffer_ += separator_;
+                  flush_if_full();
+               }
+            }
+         }
+
+         void flush() {
+            if (os_ && !buffer_.empty()) {
+               os_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            }
+            buffer_.clear();
+         }
+      };
+
+      inline ostream_sink ostream(std::ostream& os, std::string_view separator = "\n") {
+         return ostream_sink(os, separator);
+      }
+
+      class file_sink {
+         static constexpr std::size_t capacity = 1 << 16;
+
+         int fd_;
+         std::vector<char> buffer_;
+
+         void write_all(char const* data, std::size_t size) {
+            while (size != 0) {
+#ifdef _WIN32
+               auto written = ::_write(fd_, data, static_cast<unsigned>(std::min<std::size_t>(size, 1u << 30)));
+#else
+               auto written = ::write(fd_, data, size);
+#endif
+               if (written < 0) {
+                  if (errno == EINTR) continue;
+                  throw std::system_error(errno, std::generic_category(), "tl::sink::file");
+               }
+               data += written;
+               size -= static_cast<std::size_t>(written);
+            }
+         }
+
+      public:
+         //Throws std::system_error if fd is negative, so that only a moved-from sink has no file
+         explicit file_sink(int fd) : fd_(fd) {
+            if (fd_ < 0) throw std::system_error(EBADF, std::generic_category(), "tl::sink::file");
+            buffer_.reserve(capacity);
+         }
+
+         file_sink(file_sink const&) = delete;
+         file_sink& operator=(file_sink const&) = delete;
+         file_sink(file_sink&& other) noexcept : fd_(std::exchange(other.fd_, -1)), buffer_(std::move(other.buffer_)) {}
+
+         ~file_sink() {
+            try {
+               flush();
+            }
+            catch (std::system_error const&) {
+               //Nowhere to report it. Call flush() first to see errors.
+            }
+         }
+
+         template <class T>
+         requires std::is_trivially_copyable_v<T>
+         void put(std::span<T const> block) {
+            auto bytes = std::as_bytes(block);
+            auto data = reinterpret_cast<char const*>(bytes.data());
+            if (buffer_.size() + bytes.size() > capacity) {
+               flush();
+               if (bytes.size() >= capacity) {
+                  write_all(data, bytes.size());
+                  return;
+               }
+            }
+            buffer_.insert(buffer_.end(), data, data + bytes.size());
+         }
+
+         void flush() {
+            if (fd_ >= 0 && !buffer_.empty()) {
+               //Clear first so that a failed write isn't retried by the destructor
+               auto pending = std::exchange(buffer_, {});
+               buffer_.reserve(capacity);
+               write_all(pending.data(), pending.size());
+            }
+         }
+      };
+
+      inline file_sink file(int fd) {
+         return file_sink(fd);
+      }
+
+      template <class T, class Key>
+      class partition_sink {
+         std::vector<std::vector<T>> buckets_;
+         [[no_unique_address]] Key key_;
+
+      public:
+         partition_sink(std::size_t n, Key key) : buckets_(n == 0 ? 1 : n), key_(std::move(key)) {}
+
+         void put(std::span<T const> block) {
+            auto n = buckets_.size();
+            for (auto const& x : block) {
+               buckets_[static_cast<std::size_t>(std::invoke(key_, x)) % n].push_back(x);
+            }
+         }
+
+         std::vector<std::vector<T>>& buckets() & { return buckets_; }
+         std::vector<std::vector<T>> const& buckets() const& { return buckets_; }
+         std::vector<std::vector<T>> buckets() && { return std::move(buckets_); }
+      };
+
+      template <class T, class Key>
+      partition_sink<T, Key> partition(std::size_t n, Key key) {
+         return partition_sink<T, Key>(n, std::move(key));
+      }
+   }
+
+   namespace detail {
+      //Enough elements to amortise a put without using much stack
+      template <class T>
+      constexpr std::size_t staging_block = std::max<std::size_t>(1024 / sizeof(T), 16);
+
+      struct copy_fn_base {
+         template <std::ranges::input_range R, class S>
+         requires sink_for<S, std::ranges::range_value_t<R>>
+         void operator()(R&& r, S& s) const {
+            using T = std::ranges::range_value_t<R>;
+            if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+               std::same_as<std::remove_cv_t<std::remove_reference_t<std::ranges::range_reference_t<R>>>, T>) {
+               s.put(std::span<T const>(std::ranges::data(r), std::ranges::size(r)));
+            }
+            else if constexpr (std::default_initializable<T> && std::is_move_assignable_v<T>) {
+               std::array<T, staging_block<T>> block;
+               std::size_t n = 0;
+               for (auto&& x : r) {
+                  block[n++] = std::forward<decltype(x)>(x);
+                  if (n == block.size()) {
+                     s.put(std::span<T const>(block.data(), n));
+                     n = 0;
+                  }
+               }
+               if (n != 0) s.put(std::span<T const>(block.data(), n));
+            }
+            else {
+               for (auto&& x : r) {
+                  T value(std::forward<decltype(x)>(x));
+                  s.put(std::span<T const>(std::addressof(value), 1));
+               }
+            }
+         }
+
+         template <std::ranges::input_range R, class S>
+         requires sink_for<S, std::ranges::range_value_t<R>>
+         void operator()(R&& r, std::reference_wrapper<S> s) const {
+            (*this)(std::forward<R>(r), s.get());
+         }
+      };
+
+      struct copy_fn : copy_fn_base {
+         using copy_fn_base::operator();
+
+         template <class S>
+         requires (!std::ranges::range<S>)
+         constexpr auto operator()(S& s) const {
+            return pipeable(bind_back(copy_fn_base{}, std::ref(s)));
+         }
+      };
+   }
+
+   //Writes r to the sink s
+   inline constexpr detail::copy_fn copy;
+
+   template <std::ranges::input_range R, class S>
+   requires sink_for<S, std::ranges::range_value_t<R>>
+   void to(R&& r, S& s) {
+      tl::copy(std::forward<R>(r), s);
+   }
+
+   template <class S>
+   requires (!std::ranges::range<S>)
+   auto to(S& s) {
+      return tl::copy(s);
+   }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "basic_iterator.hpp"
 #include "functional/pipeable.hpp"
 #include "functional/bind.hpp"
+#include "strided_span.hpp"
 
 namespace tl {
    template <std::ranges::forward_range V>
@@ -193,6 +194,23 @@ namespace tl {
          return (std::ranges::size(base_) + stride_size_ - 1) / stride_size_;
       }
 
+      //For contiguous bases the elements are a fixed distance apart in memory
+      constexpr auto as_strided_span() requires (std::ranges::contiguous_range<V> && am_sized<V>) {
+         return strided_span(std::ranges::data(base_), static_cast<std::size_t>(size()), stride_size_);
+      }
+
+      constexpr auto as_strided_span() const requires (std::ranges::contiguous_range<const V> && am_sized<const V>) {
+         return strided_span(std::ranges::data(base_), static_cast<std::size_t>(size()), stride_size_);
+      }
+
+      //Writes the first out.size() elements to out. Used by tl::to.
+      template <class T>
+      void copy_to(std::span<T> out) const
+         requires (std::ranges::contiguous_range<const V> && am_sized<const V> &&
+            std::same_as<T, std::ranges::range_value_t<const V>>) {
+         as_strided_span().copy_to(out);
+      }
+
       auto& base() {
          return base_;
       }
@@ -0,0 +1,202 @@
+#ifndef TL_RANGES_STRIDED_SPAN_HPP
+#define TL_RANGES_STRIDED_SPAN_HPP
+
+//tl::strided_span<T> is a view of extent elements of an array which are stride elements apart, e.g. column j of a
+//row-major rows x cols matrix is tl::strided_span(data + j, rows, cols). tl::stride_view of a contiguous range gives
+//one with as_strided_span().
+//
+//tl::strided_copy(s, out) copies the elements of a strided span to contiguous memory. When T is a 4 or 8 byte
+//arithmetic type and AVX2 is enabled, e.g. with -mavx2 or /arch:AVX2, it gathers a register of elements per
+//instruction; otherwise it's an unrolled scalar loop. tl::to and tl::fold_left use it and the span's indexing rather
+//than stepping a stride_view iterator, which has to check for the end of the base range on every step.
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include "basic_iterator.hpp"
+
+#if defined(__AVX2__)
+#define TL_RANGES_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace tl {
+   template <class T>
+   class strided_span : public std::ranges::view_interface<strided_span<T>> {
+      T* data_ = nullptr;
+      std::size_t extent_ = 0;
+      std::ptrdiff_t stride_ = 1;
+
+      //Stores an index rather than a pointer, because stepping a pointer past the last element by a whole stride
+      //could point outside the array
+      class cursor {
+         T* data_ = nullptr;
+         std::ptrdiff_t stride_ = 1;
+         std::ptrdiff_t index_ = 0;
+
+      public:
+         cursor() = default;
+         cursor(T* data, std::ptrdiff_t stride, std::ptrdiff_t index) : data_(data), stride_(stride), index_(index) {}
+
+         T& read() const {
+            return data_[index_ * stride_];
+         }
+
+         void next() {
+            ++index_;
+         }
+         void prev() {
+            --index_;
+         }
+         void advance(std::ptrdiff_t n) {
+            index_ += n;
+         }
+
+         bool equal(cursor const& rhs) const {
+            return index_ == rhs.index_;
+         }
+         std::ptrdiff_t distance_to(cursor const& rhs) const {
+            return rhs.index_ - index_;
+         }
+      };
+
+   public:
+      using element_type = T;
+      using value_type = std::remove_cv_t<T>;
+
+      strided_span() = default;
+      strided_span(T* data, std::size_t extent, std::ptrdiff_t stride)
+         : data_(data), extent_(extent), stride_(stride) {}
+
+      auto begin() const {
+         return basic_iterator{ cursor{ data_, stride_, 0 } };
+      }
+      auto end() const {
+         return basic_iterator{ cursor{ data_, stride_, static_cast<std::ptrdiff_t>(extent_) } };
+      }
+
+      T& operator[](std::size_t i) const {
+         return data_[static_cast<std::ptrdiff_t>(i) * stride_];
+      }
+
+      T* data() const { return data_; }
+      std::size_t size() const { return extent_; }
+      std::ptrdiff_t stride() const { return stride_; }
+
+      //Writes the first out.size() elements to out. Used by tl::to.
+      void copy_to(std::span<value_type> out) const;
+   };
+
+   template <class T>
+   strided_span(T*, std::size_t, std::ptrdiff_t)->strided_span<T>;
+
+   namespace detail {
+#ifdef TL_RANGES_AVX2
+      namespace avx2 {
+         template <class T>
+         constexpr bool gatherable = std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+         //Stores a whole register. GCC warns that this may write past the end of any output which it can see is shorter
+         //than a register, even though the loop never runs for those.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+         template <class T>
+         void store(T* out, __m256i v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+         }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+         //Copies the first n elements a register at a time and returns how many were copied. The element offsets
+         //within a register are 32-bit, so very large strides are left to the scalar loop. The masked gathers, with
+         //every lane enabled, are used because GCC warns about the unmasked ones reading an uninitialised register.
+         template <class T>
+         std::size_t gather(T const* in, std::ptrdiff_t stride, T* out, std::size_t n) {
+            constexpr std::ptrdiff_t lanes = 32 / sizeof(T);
+            if (stride > std::numeric_limits<std::int32_t>::max() / lanes ||
+                stride < std::numeric_limits<std::int32_t>::min() / lanes) {
+               return 0;
+            }
+            auto s = static_cast<std::int32_t>(stride);
+            std::size_t i = 0;
+            if constexpr (sizeof(T) == 4) {
+               auto offsets = _mm256_mullo_epi32(_mm256_set1_epi32(s), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+               for (; i + lanes <= n; i += lanes) {
+                  auto base = in + static_cast<std::ptrdiff_t>(i) * stride;
+                  if constexpr (std::same_as<T, float>) {
+                     store(out + i, _mm256_castps_si256(_mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, offsets,
+                        _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4)));
+                  }
+                  else {
+                     store(out + i, _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<int const*>(base),
+                        offsets, _mm256_set1_epi32(-1), 4));
+                  }
+               }
+            }
+            else {
+               auto offsets = _mm_mullo_epi32(_mm_set1_epi32(s), _mm_setr_epi32(0, 1, 2, 3));
+               for (; i + lanes <= n; i += lanes) {
+                  auto base = in + static_cast<std::ptrdiff_t>(i) * stride;
+                  if constexpr (std::same_as<T, double>) {
+                     store(out + i, _mm256_castpd_si256(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, offsets,
+                        _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8)));
+                  }
+                  else {
+                     store(out + i, _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                        reinterpret_cast<long long const*>(base), offsets, _mm256_set1_epi64x(-1), 8));
+                  }
+               }
+            }
+            return i;
+         }
+      }
+#endif
+   }
+
+   template <class T>
+   void strided_copy(strided_span<T> in, std::remove_cv_t<T>* out) {
+      using U = std::remove_cv_t<T>;
+      auto data = in.data();
+      auto stride = in.stride();
+      auto n = in.size();
+      std::size_t i = 0;
+#ifdef TL_RANGES_AVX2
+      if constexpr (detail::avx2::gatherable<U>) {
+         i = detail::avx2::gather<U>(data, stride, out, n);
+      }
+#endif
+      //Independent loads, so they can all be in flight at once
+      for (; i + 4 <= n; i += 4) {
+         auto p = data + static_cast<std::ptrdiff_t>(i) * stride;
+         U a = p[0], b = p[stride], c = p[2 * stride], d = p[3 * stride];
+         out[i] = a;
+         out[i + 1] = b;
+         out[i + 2] = c;
+         out[i + 3] = d;
+      }
+      for (; i < n; ++i) {
+         out[i] = data[static_cast<std::ptrdiff_t>(i) * stride];
+      }
+   }
+
+   template <class T>
+   void strided_span<T>::copy_to(std::span<value_type> out) const {
+      auto n = out.size() < extent_ ? out.size() : extent_;
+      strided_copy(strided_span(data_, n, stride_), out.data());
+   }
+}
+
+namespace std::ranges {
+   template <class T>
+   inline constexpr bool enable_borrowed_range<tl::strided_span<T>> = true;
+}
+
+#endif
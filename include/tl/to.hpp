@@ -4,6 +4,9 @@
 #include <ranges>
 #include <iterator>
 #include <algorithm>
+#include <span>
+#include "utility/parallel.hpp"
+#include "utility/repeated.hpp"
 
 namespace tl {
    namespace detail {
@@ -47,6 +50,23 @@ namespace tl {
          friend bool operator==(fake_input_iterator a, fake_input_iterator b) { return false; }
       };
 
+      //R is a repeated value which C can be constructed from directly, like std::vector(n, value)
+      template <class C, class R>
+      concept fill_constructible = repeated_range<R> && requires {
+         typename C::size_type;
+         typename C::value_type;
+      } && std::constructible_from<typename C::value_type, std::ranges::range_reference_t<R>> &&
+         std::constructible_from<C, typename C::size_type, typename C::value_type const&>;
+
+      //R can write all of its elements to contiguous storage in one call, e.g. tl::generate_n_view of a tl::batch_generator
+      template <class C, class R>
+      concept bulk_copyable = std::ranges::sized_range<R> && std::ranges::contiguous_range<C> &&
+         std::default_initializable<C> && std::same_as<std::ranges::range_value_t<C>, std::ranges::range_value_t<R>> &&
+         requires(C & c, R & r, std::ranges::range_size_t<C> n) {
+            c.resize(n);
+            r.copy_to(std::span<std::ranges::range_value_t<C>>(c));
+      };
+
       template <template <typename...> typename C, std::ranges::input_range R, typename... Args>
       struct ctad_container {
          template <class V = R>
@@ -62,8 +82,20 @@ namespace tl {
    template <std::ranges::input_range C, std::ranges::input_range R, typename... Args>
    requires (!std::ranges::view<C>)
       constexpr C to(R&& r, Args&&... args) {
+      //Fill with a repeated value in one go rather than inserting it n times
+      if constexpr (sizeof...(Args) == 0 && detail::fill_constructible<C, R>) {
+         return C(static_cast<typename C::size_type>(detail::repeated_count(r)),
+            typename C::value_type(detail::repeated_value(r)));
+      }
+      //Let the range write its elements straight into the container
+      else if constexpr (sizeof...(Args) == 0 && detail::bulk_copyable<C, R>) {
+         C c;
+         c.resize(static_cast<std::ranges::range_size_t<C>>(std::ranges::size(r)));
+         r.copy_to(std::span<std::ranges::range_value_t<C>>(c));
+         return c;
+      }
       //Construct from range
-      if constexpr (std::constructible_from<C, R, Args...>) {
+      else if constexpr (std::constructible_from<C, R, Args...>) {
          return C(std::forward<R>(r), std::forward<Args>(args)...);
       }
       //Construct and copy (potentially reserving memory)
@@ -101,6 +133,49 @@ namespace tl {
       return tl::to<ContainerType>(std::forward<R>(r), std::forward<Args>(args)...);
    }
 
+   namespace detail {
+      //C can be sized up front and then have blocks of R copied into it independently
+      template <class C, class R>
+      concept parallel_fillable = std::ranges::random_access_range<C> && std::ranges::random_access_range<R> &&
+         std::ranges::sized_range<R> && std::default_initializable<C> &&
+         std::indirectly_copyable<std::ranges::iterator_t<R>, std::ranges::iterator_t<C>> &&
+         requires(C & c, std::ranges::range_size_t<C> n) { c.resize(n); };
+   }
+
+   //Parallel materialisation. If C can be resized up front, e.g. std::vector, then blocks of r are evaluated and copied into
+   //place concurrently on the policy's pool, which pays off when r computes its elements, e.g. r | std::views::transform(f).
+   //Otherwise this is the same as tl::to<C>(r).
+   template <std::ranges::input_range C, std::ranges::input_range R>
+   requires (!std::ranges::view<C>)
+   C to(parallel_policy policy, R&& r) {
+      if constexpr (detail::fill_constructible<C, R>) {
+         return tl::to<C>(std::forward<R>(r));
+      }
+      else if constexpr (detail::parallel_fillable<C, R>) {
+         constexpr std::size_t min_block = 1 << 10;
+         auto n = static_cast<std::size_t>(std::ranges::size(r));
+         C c;
+         c.resize(static_cast<std::ranges::range_size_t<C>>(n));
+         auto in = std::ranges::begin(r);
+         auto out = std::ranges::begin(c);
+         detail::parallel_for_blocks(policy, detail::block_count(policy, n, min_block), n,
+            [&](std::size_t, std::size_t first, std::size_t last) {
+               std::ranges::copy(in + static_cast<std::ranges::range_difference_t<R>>(first),
+                  in + static_cast<std::ranges::range_difference_t<R>>(last),
+                  out + static_cast<std::ranges::range_difference_t<C>>(first));
+            });
+         return c;
+      }
+      else {
+         return tl::to<C>(std::forward<R>(r));
+      }
+   }
+
+   template <template <typename...> typename C, std::ranges::input_range R, class ContainerType = typename detail::ctad_container<C, R>::type>
+   auto to(parallel_policy policy, R&& r) -> ContainerType {
+      return tl::to<ContainerType>(policy, std::forward<R>(r));
+   }
+
    namespace detail {
       template <std::ranges::input_range C, class... Args>
       struct closure_range {
@@ -0,0 +1,125 @@
+#ifndef TL_RANGES_TOP_K_HPP
+#define TL_RANGES_TOP_K_HPP
+
+#include <ranges>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "utility/parallel.hpp"
+
+//tl::top_k(r, k, comp, proj) returns the first k elements of r as if it were sorted by comp and proj, in that order,
+//like std::ranges::partial_sort_copy but in one pass over an input range, keeping only the best k elements seen so far
+//in a bounded heap. So it takes O(k) memory and O(n log k) comparisons.
+//comp defaults to std::ranges::less, which gives the k smallest elements. Use std::ranges::greater for the k largest, e.g.
+//
+//auto best = tl::top_k(scores | std::views::transform(score), 100, std::ranges::greater{});
+//
+//tl::top_k(tl::par, r, k, comp, proj) does the same for sized random-access ranges by finding the top k of blocks of r
+//in parallel on the policy's pool, then merging the per-block heaps.
+
+namespace tl {
+   namespace detail {
+      template <class R, class Comp, class Proj>
+      concept top_k_able = std::ranges::input_range<R> &&
+         std::constructible_from<std::ranges::range_value_t<R>, std::ranges::range_reference_t<R>> &&
+         std::movable<std::ranges::range_value_t<R>> &&
+         std::sortable<typename std::vector<std::ranges::range_value_t<R>>::iterator, Comp, Proj> &&
+         std::indirect_strict_weak_order<Comp,
+            std::projected<std::ranges::iterator_t<R>, Proj>,
+            std::projected<typename std::vector<std::ranges::range_value_t<R>>::iterator, Proj>>;
+
+      //Keeps the best k elements seen so far in a heap whose front is the worst of them.
+      //Space is reserved for up to expected elements, so a large k doesn't allocate more than the input needs.
+      template <class T, class Comp, class Proj>
+      class bounded_heap {
+         std::vector<T> heap_;
+         std::size_t k_;
+         Comp& comp_;
+         Proj& proj_;
+
+      public:
+         bounded_heap(std::size_t k, std::size_t expected, Comp& comp, Proj& proj) : k_(k), comp_(comp), proj_(proj) {
+            heap_.reserve(std::min(k, expected));
+         }
+
+         template <class U>
+         void push(U&& element) {
+            if (heap_.size() < k_) {
+               heap_.emplace_back(std::forward<U>(element));
+               std::ranges::push_heap(heap_, comp_, proj_);
+            }
+            //Only copy the element if it's better than the worst one being kept
+            else if (k_ != 0 && std::invoke(comp_, std::invoke(proj_, element), std::invoke(proj_, heap_.front()))) {
+               std::ranges::pop_heap(heap_, comp_, proj_);
+               heap_.back() = T(std::forward<U>(element));
+               std::ranges::push_heap(heap_, comp_, proj_);
+            }
+         }
+
+         template <class I, class S>
+         void push(I first, S last) {
+            for (; first != last; ++first) {
+               push(*first);
+            }
+         }
+
+         std::vector<T>& elements() {
+            return heap_;
+         }
+
+         std::vector<T> sorted() && {
+            std::ranges::sort_heap(heap_, comp_, proj_);
+            return std::move(heap_);
+         }
+      };
+   }
+
+   template <std::ranges::input_range R, class Comp = std::ranges::less, class Proj = std::identity>
+   requires detail::top_k_able<R, Comp, Proj>
+   std::vector<std::ranges::range_value_t<R>> top_k(R&& r, std::size_t k, Comp comp = {}, Proj proj = {}) {
+      std::size_t expected = 0;
+      if constexpr (std::ranges::sized_range<R>) {
+         expected = static_cast<std::size_t>(std::ranges::size(r));
+      }
+      detail::bounded_heap<std::ranges::range_value_t<R>, Comp, Proj> heap(k, expected, comp, proj);
+      heap.push(std::ranges::begin(r), std::ranges::end(r));
+      return std::move(heap).sorted();
+   }
+
+   template <std::ranges::random_access_range R, std::copy_constructible Comp = std::ranges::less,
+      std::copy_constructible Proj = std::identity>
+   requires (std::ranges::sized_range<R> && detail::top_k_able<R, Comp, Proj>)
+   std::vector<std::ranges::range_value_t<R>> top_k(parallel_policy policy, R&& r, std::size_t k, Comp comp = {}, Proj proj = {}) {
+      using T = std::ranges::range_value_t<R>;
+      using difference_type = std::ranges::range_difference_t<R>;
+      //Each block ends up with up to k elements to merge, so make sure that's small compared to the block
+      auto min_block = std::max<std::size_t>(std::size_t(1) << 14, 8 * k);
+
+      auto n = static_cast<std::size_t>(std::ranges::distance(r));
+      auto blocks = detail::block_count(policy, n, min_block);
+      if (blocks <= 1) return tl::top_k(r, k, std::move(comp), std::move(proj));
+
+      std::vector<std::vector<T>> heaps(blocks);
+      detail::parallel_for_blocks(policy, blocks, n, [&](std::size_t block, std::size_t first, std::size_t last) {
+         auto block_comp = comp;
+         auto block_proj = proj;
+         detail::bounded_heap<T, Comp, Proj> heap(k, last - first, block_comp, block_proj);
+         auto begin = std::ranges::begin(r);
+         heap.push(begin + static_cast<difference_type>(first), begin + static_cast<difference_type>(last));
+         heaps[block] = std::move(heap.elements());
+      });
+
+      std::size_t merged = 0;
+      for (auto& heap : heaps) merged += heap.size();
+      detail::bounded_heap<T, Comp, Proj> result(k, merged, comp, proj);
+      for (auto& heap : heaps) {
+         result.push(std::make_move_iterator(heap.begin()), std::make_move_iterator(heap.end()));
+      }
+      return std::move(result).sorted();
+   }
+}
+
+#endif
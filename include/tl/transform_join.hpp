@@ -1,13 +1,160 @@
 #ifndef TL_RANGES_TRANSFORM_JOIN_HPP
 #define TL_RANGES_TRANSFORM_JOIN_HPP
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
 #include <ranges>
 #include <utility>
+#include <vector>
+#include "basic_iterator.hpp"
 #include "functional/pipeable.hpp"
 #include "functional/bind.hpp"
-#include "cache_latest.hpp"
+#include "utility/non_propagating_cache.hpp"
+#include "utility/semiregular_box.hpp"
+
+//tl::views::transform_join(f) is f applied to each element, with the resulting ranges joined together. If f returns a
+//view or a reference to a range, it's the same as std::views::transform(f) | std::views::join.
+//
+//If f returns a container by value, each one is held in the view while its elements are visited, which makes the
+//result single-pass. tl::views::transform_join_into<T>(f) avoids building a new container for each element:
+//f(element, out) appends to a std::vector<T>& out, which is cleared and reused for every element, so its memory is
+//only allocated while it grows to fit the largest inner range. An optional capacity hint reserves that up front, e.g.
+//
+//auto words = lines | tl::views::transform_join_into<std::string_view>(
+//   [](std::string const& line, auto& out) { split_into(line, out); }, 32);
+//
+//Both single-pass forms also have for_each_segment(g), which calls g with each non-empty inner range in turn, so that
+//g can loop over it directly rather than checking for the end of each inner range on every step of the joined range.
 
 namespace tl {
+   namespace detail {
+      //The inner range is either the buffer which F writes to, or what F returns
+      template <class V, class F, class Buffer>
+      struct transform_join_inner {
+         using type = Buffer;
+      };
+      template <class V, class F>
+      struct transform_join_inner<V, F, void> {
+         using type = std::views::all_t<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>>;
+      };
+   }
+
+   template <std::ranges::input_range V, class F, class Buffer = void>
+   requires (std::ranges::view<V> && std::is_object_v<F>)
+   class transform_join_view : public std::ranges::view_interface<transform_join_view<V, F, Buffer>> {
+      static constexpr bool filling = !std::is_void_v<Buffer>;
+
+      using inner_type = typename detail::transform_join_inner<V, F, Buffer>::type;
+
+      struct state {
+         std::ranges::iterator_t<V> outer_;
+         std::conditional_t<filling, inner_type, std::optional<inner_type>> inner_{};
+         std::ranges::iterator_t<inner_type> inner_it_{};
+      };
+
+      V base_;
+      [[no_unique_address]] tl::semiregular_storage_for<F> func_;
+      std::size_t capacity_hint_ = 0;
+      non_propagating_cache<state> state_;
+
+      constexpr F& func() {
+         if constexpr (std::semiregular<F>) return func_;
+         else return *func_;
+      }
+
+      inner_type& inner() {
+         if constexpr (filling) return state_->inner_;
+         else return *state_->inner_;
+      }
+
+      //Computes the inner range for the current outer element
+      void load() {
+         auto& s = *state_;
+         if constexpr (filling) {
+            s.inner_.clear();
+            std::invoke(func(), *s.outer_, s.inner_);
+         }
+         else {
+            s.inner_.emplace(std::views::all(std::invoke(func(), *s.outer_)));
+         }
+      }
+
+      //Moves to the first element of the first non-empty inner range from the current outer element on
+      void satisfy() {
+         auto& s = *state_;
+         for (; s.outer_ != std::ranges::end(base_); ++s.outer_) {
+            load();
+            s.inner_it_ = std::ranges::begin(inner());
+            if (s.inner_it_ != std::ranges::end(inner())) return;
+         }
+      }
+
+      void start() {
+         state_.emplace(state{ std::ranges::begin(base_) });
+         if constexpr (filling) {
+            state_->inner_.reserve(capacity_hint_);
+         }
+      }
+
+      struct cursor {
+         transform_join_view* parent_ = nullptr;
+
+         constexpr static bool single_pass = true;
+
+         cursor() = default;
+         explicit cursor(transform_join_view* parent) : parent_(parent) {}
+
+         decltype(auto) read() const {
+            return *parent_->state_->inner_it_;
+         }
+
+         void next() {
+            auto& s = *parent_->state_;
+            if (++s.inner_it_ == std::ranges::end(parent_->inner())) {
+               ++s.outer_;
+               parent_->satisfy();
+            }
+         }
+
+         bool equal(std::default_sentinel_t) const {
+            return parent_->state_->outer_ == std::ranges::end(parent_->base_);
+         }
+      };
+
+   public:
+      transform_join_view() = default;
+      transform_join_view(V base, F f, std::size_t capacity_hint = 0)
+         : base_(std::move(base)), func_(std::move(f)), capacity_hint_(capacity_hint) {}
+
+      auto begin() {
+         start();
+         satisfy();
+         return basic_iterator{ cursor{ this } };
+      }
+
+      auto end() {
+         return std::default_sentinel;
+      }
+
+      //Calls g with each non-empty inner range in turn
+      template <class G>
+      void for_each_segment(G g) {
+         start();
+         auto& s = *state_;
+         for (; s.outer_ != std::ranges::end(base_); ++s.outer_) {
+            load();
+            if (!std::ranges::empty(inner())) std::invoke(g, inner());
+         }
+      }
+
+      V base() const& requires std::copy_constructible<V> {
+         return base_;
+      }
+      V base()&& { return std::move(base_); }
+   };
+
    namespace views {
       namespace detail {
          template <class V, class F>
@@ -20,21 +167,26 @@ namespace tl {
             std::ranges::join_view{ std::forward<V>(v) };
          };
 
+         //f returns a container by value, which would have to be held somewhere while it's joined
+         template <class V, class F>
+         concept returns_container = std::ranges::input_range<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>> &&
+            !std::is_reference_v<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>> &&
+            !std::ranges::view<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>>;
+
          struct transform_join_fn_base {
             template <std::ranges::viewable_range V, class F>
             constexpr auto operator()(V&& v, F f) const
                requires (transformable_view<V, F> &&
-                  (joinable_view<std::ranges::transform_view<std::views::all_t<V>, F>> ||
-                     joinable_view<tl::cache_latest_view<std::ranges::transform_view<std::views::all_t<V>, F>>>)) {
-               if constexpr (joinable_view<std::ranges::transform_view<std::views::all_t<V>, F>>) {
+                  (joinable_view<std::ranges::transform_view<std::views::all_t<V>, F>> || returns_container<V, F>)) {
+               if constexpr (!returns_container<V, F>) {
                   return v | std::views::transform(f) | std::views::join;
                }
                else {
-                  return v | std::views::transform(f) | tl::views::cache_latest | std::views::join;
+                  return tl::transform_join_view<std::views::all_t<V>, F>(std::views::all(std::forward<V>(v)), std::move(f));
                }
             }
          };
-            
+
          struct transform_join_fn : transform_join_fn_base {
             using transform_join_fn_base::operator();
 
@@ -43,10 +195,34 @@ namespace tl {
                return pipeable(bind_back(transform_join_fn_base{}, std::move(f)));
             }
          };
+
+         template <class T>
+         struct transform_join_into_fn_base {
+            template <std::ranges::viewable_range V, class F>
+            constexpr auto operator()(V&& v, F f, std::size_t capacity_hint = 0) const
+               requires (std::ranges::input_range<V> &&
+                  std::invocable<F&, std::ranges::range_reference_t<V>, std::vector<T>&>) {
+               return tl::transform_join_view<std::views::all_t<V>, F, std::vector<T>>(
+                  std::views::all(std::forward<V>(v)), std::move(f), capacity_hint);
+            }
+         };
+
+         template <class T>
+         struct transform_join_into_fn : transform_join_into_fn_base<T> {
+            using transform_join_into_fn_base<T>::operator();
+
+            template <class F>
+            constexpr auto operator()(F f, std::size_t capacity_hint = 0) const {
+               return pipeable(bind_back(transform_join_into_fn_base<T>{}, std::move(f), capacity_hint));
+            }
+         };
       }
 
       constexpr inline auto transform_join = detail::transform_join_fn{};
+
+      template <class T>
+      constexpr inline detail::transform_join_into_fn<T> transform_join_into{};
    }
 }
 
-#endif 
\ No newline at end of file
+#endif
@@ -15,22 +15,33 @@ namespace tl {
    requires std::ranges::view<V>
    class transform_maybe_view : public std::ranges::view_interface<transform_maybe_view<V,F>> {
    private:
+      using result_type = std::remove_cvref_t<std::invoke_result_t<F&, std::ranges::range_reference_t<V>>>;
+      static constexpr inline bool single_pass = detail::single_pass_iterator<std::ranges::iterator_t<V>>;
+
+      //The first element which returns an engaged optional, along with that result
+      struct begin_cache {
+         std::ranges::iterator_t<V> it;
+         result_type value;
+      };
+
       V base_;
       //Might need to wrap F in a semiregular_box to ensure the view is moveable and default-initializable
       [[no_unique_address]] semiregular_storage_for<F> func_;
-      //Need to cache begin so that begin(transform_maybe_view) is amortized O(1)
-      non_propagating_cache<std::ranges::iterator_t<V>> begin_;
+      //Need to cache begin so that begin(transform_maybe_view) is amortized O(1).
+      //The result for the first element is cached alongside it so that the function isn't called on it twice.
+      //For single-pass ranges there's only ever one cursor, so this is also where it keeps the current result.
+      non_propagating_cache<begin_cache> begin_;
 
       //Work out which is the first element which returns an engaged optional and cache it
-      auto get_begin() {
+      begin_cache& get_begin() {
          if (begin_) return *begin_;
 
-         auto it = std::ranges::begin(base_);
-         while (it != std::ranges::end(base_) && !std::invoke(func_, *it)) {
-            ++it;
-         };
-         begin_.emplace(std::move(it));
-         return *begin_;
+         auto& cache = begin_.emplace(std::ranges::begin(base_), result_type{});
+         for (; cache.it != std::ranges::end(base_); ++cache.it) {
+            cache.value = std::invoke(func_, *cache.it);
+            if (cache.value) break;
+         }
+         return cache;
       }
 
       struct sentinel {
@@ -39,45 +50,54 @@ namespace tl {
          constexpr sentinel(std::ranges::sentinel_t<V> end) : end_(std::move(end)) {}
       };
 
+      struct no_cache {};
+
       struct cursor {
-         static constexpr inline bool single_pass = detail::single_pass_iterator<std::ranges::iterator_t<V>>;
+         static constexpr inline bool single_pass = transform_maybe_view::single_pass;
 
          std::ranges::iterator_t<V> current_;
          transform_maybe_view* parent_;
-         std::remove_cvref_t<std::invoke_result_t<F, std::ranges::range_reference_t<V>>> cache_;
+         [[no_unique_address]] std::conditional_t<single_pass, no_cache, result_type> cache_;
 
-         cursor() = default;
-         constexpr cursor(transform_maybe_view* parent)
-            : current_(parent->get_begin()), parent_(parent) {
-            cache_ = std::invoke(parent_->func_, *current_);
+         result_type& cache() {
+            if constexpr (single_pass) return parent_->begin_->value;
+            else return cache_;
+         }
+         result_type const& cache() const {
+            if constexpr (single_pass) return parent_->begin_->value;
+            else return cache_;
          }
+
+         cursor() = default;
+         constexpr cursor(transform_maybe_view* parent) : cursor(parent, parent->get_begin()) {}
+         constexpr cursor(transform_maybe_view* parent, begin_cache& begin) requires single_pass
+            : current_(std::move(begin.it)), parent_(parent) {}
+         constexpr cursor(transform_maybe_view* parent, begin_cache& begin) requires (!single_pass)
+            : current_(begin.it), parent_(parent), cache_(begin.value) {}
          constexpr cursor(as_sentinel_t, transform_maybe_view* parent)
             : current_(std::ranges::end(parent->base_)), parent_(parent) {}
 
          auto const& read() const {
-            return *cache_;
+            return *cache();
          }
 
          //Walk forward until we find end, or element which returns an engaged optional and cache the result
          void next() {
-            decltype(cache_) result = std::nullopt;
-            do {
-               ++current_;
-               if (current_ == std::ranges::end(parent_->base_)) return;
-               result = std::invoke(parent_->func_, *current_);
-            } while (!result);
-            cache_ = std::move(result);
+            while (++current_ != std::ranges::end(parent_->base_)) {
+               cache() = std::invoke(parent_->func_, *current_);
+               if (cache()) return;
+            }
          }
 
-         //Walk backwards until we find begin, or element which returns an engaged optional and cache the result
+         //Walk backwards until we find begin, or element which returns an engaged optional and cache the result.
+         //begin is cached by now, because end() caches it for bidirectional ranges.
          void prev() {
-            decltype(cache_) result = std::nullopt;
-            do {
-               --current_;
-               if (current_ == parent_->get_begin()) return;
-               result = std::invoke(parent_->func_, *current_);
-            } while (!result);
-            cache_ = std::move(result);
+            auto& begin = *parent_->begin_;
+            while (--current_ != begin.it) {
+               cache_ = std::invoke(parent_->func_, *current_);
+               if (cache_) return;
+            }
+            cache_ = begin.value;
          }
 
          bool equal(cursor const& s) const {
@@ -0,0 +1,113 @@
+#ifndef TL_RANGES_UNIQUE_HPP
+#define TL_RANGES_UNIQUE_HPP
+
+#include <ranges>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "basic_iterator.hpp"
+#include "functional/bind.hpp"
+#include "functional/pipeable.hpp"
+#include "utility/semiregular_box.hpp"
+#include "utility/adjacent_mismatch.hpp"
+
+//tl::views::unique skips elements which are equal to the one before them, keeping the first of each run, like std::unique.
+//e.g. {1, 1, 2, 3, 3, 1} | tl::views::unique is {1, 2, 3, 1}
+//tl::views::unique(pred) uses pred, which must be an equivalence relation, to decide whether elements are equal.
+//
+//Runs are skipped with the same search as chunk_by_view, so for contiguous ranges of arithmetic types and the
+//standard comparison function objects, whole SSE2 registers of elements are compared at a time.
+//To drop all repeated elements rather than adjacent ones, see tl::views::distinct.
+
+namespace tl {
+   template <std::ranges::forward_range V, class Pred>
+   requires (std::ranges::view<V> && std::is_object_v<Pred> &&
+      std::indirect_equivalence_relation<Pred const, std::ranges::iterator_t<V>>)
+   class unique_view : public std::ranges::view_interface<unique_view<V, Pred>> {
+      V base_;
+      [[no_unique_address]] semiregular_storage_for<Pred> pred_;
+
+      constexpr std::ranges::iterator_t<V> find_next_unique(std::ranges::iterator_t<V> it) {
+         auto first_failed = detail::find_adjacent_mismatch(std::move(it), std::ranges::end(base_), pred_);
+         return std::ranges::next(first_failed, 1, std::ranges::end(base_));
+      }
+
+      struct sentinel {
+         std::ranges::sentinel_t<V> end_;
+         sentinel() = default;
+         constexpr sentinel(std::ranges::sentinel_t<V> end) : end_(std::move(end)) {}
+      };
+
+      struct cursor {
+         std::ranges::iterator_t<V> current_;
+         unique_view* parent_ = nullptr;
+
+         cursor() = default;
+         constexpr cursor(std::ranges::iterator_t<V> current, unique_view* parent)
+            : current_(std::move(current)), parent_(parent) {}
+
+         constexpr decltype(auto) read() const {
+            return *current_;
+         }
+
+         constexpr void next() {
+            current_ = parent_->find_next_unique(std::move(current_));
+         }
+
+         constexpr bool equal(cursor const& rhs) const {
+            return current_ == rhs.current_;
+         }
+         constexpr bool equal(sentinel const& rhs) const {
+            return current_ == rhs.end_;
+         }
+      };
+
+   public:
+      unique_view() = default;
+      unique_view(V base, Pred pred) : base_(std::move(base)), pred_(std::move(pred)) {}
+
+      constexpr auto begin() {
+         return basic_iterator{ cursor{ std::ranges::begin(base_), this } };
+      }
+
+      constexpr auto end() {
+         return sentinel{ std::ranges::end(base_) };
+      }
+
+      auto& base() {
+         return base_;
+      }
+   };
+
+   template <class R, class Pred>
+   unique_view(R&&, Pred)->unique_view<std::views::all_t<R>, Pred>;
+
+   namespace views {
+      namespace detail {
+         struct unique_fn_base {
+            template <std::ranges::viewable_range R, class Pred = std::ranges::equal_to>
+            requires (std::ranges::forward_range<R> &&
+               std::indirect_equivalence_relation<Pred const, std::ranges::iterator_t<R>>)
+            constexpr auto operator()(R&& r, Pred pred = {}) const {
+               return unique_view(std::forward<R>(r), std::move(pred));
+            }
+         };
+
+         struct unique_fn : unique_fn_base {
+            using unique_fn_base::operator();
+
+            template <class Pred>
+            requires (!std::ranges::range<Pred>)
+            constexpr auto operator()(Pred pred) const {
+               return pipeable(bind_back(unique_fn_base{}, std::move(pred)));
+            }
+         };
+      }
+
+      constexpr inline auto unique = pipeable(detail::unique_fn{});
+   }
+}
+
+#endif
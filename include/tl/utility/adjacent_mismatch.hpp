@@ -0,0 +1,170 @@
+#ifndef TL_RANGES_UTILITY_ADJACENT_MISMATCH_HPP
+#define TL_RANGES_UTILITY_ADJACENT_MISMATCH_HPP
+
+// tl::detail::find_adjacent_mismatch(first, last, pred) is the same as
+// std::ranges::adjacent_find(first, last, std::not_fn(pred)): it returns the
+// first iterator i such that pred(*i, *std::next(i)) is false, or last if
+// there is no such iterator.
+//
+// When the range is contiguous, the elements are arithmetic, and pred is one
+// of the standard comparison function objects, the search compares a whole
+// SSE2 register of adjacent pairs at a time. Compilers won't reliably
+// vectorise this search on their own because the loop exits early.
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TL_RANGES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace tl {
+   namespace detail {
+      enum class comparison {
+         equal, not_equal, less, greater, less_equal, greater_equal, other
+      };
+
+      template <class F, class T>
+      constexpr comparison comparison_for() {
+         if constexpr (std::same_as<F, std::equal_to<T>> || std::same_as<F, std::equal_to<>> || std::same_as<F, std::ranges::equal_to>)
+            return comparison::equal;
+         else if constexpr (std::same_as<F, std::not_equal_to<T>> || std::same_as<F, std::not_equal_to<>> || std::same_as<F, std::ranges::not_equal_to>)
+            return comparison::not_equal;
+         else if constexpr (std::same_as<F, std::less<T>> || std::same_as<F, std::less<>> || std::same_as<F, std::ranges::less>)
+            return comparison::less;
+         else if constexpr (std::same_as<F, std::greater<T>> || std::same_as<F, std::greater<>> || std::same_as<F, std::ranges::greater>)
+            return comparison::greater;
+         else if constexpr (std::same_as<F, std::less_equal<T>> || std::same_as<F, std::less_equal<>> || std::same_as<F, std::ranges::less_equal>)
+            return comparison::less_equal;
+         else if constexpr (std::same_as<F, std::greater_equal<T>> || std::same_as<F, std::greater_equal<>> || std::same_as<F, std::ranges::greater_equal>)
+            return comparison::greater_equal;
+         else
+            return comparison::other;
+      }
+
+#ifdef TL_RANGES_SSE2
+      namespace sse2 {
+         //SSE2 has no 64-bit ordered integer comparisons, so those fall back to the scalar search
+         template <class T, comparison C>
+         constexpr bool supported() {
+            if constexpr (C == comparison::other) return false;
+            else if constexpr (std::same_as<T, float> || std::same_as<T, double>) return true;
+            else if constexpr (!std::integral<T> || std::same_as<T, bool>) return false;
+            else if constexpr (sizeof(T) <= 4) return true;
+            else return sizeof(T) == 8 && (C == comparison::equal || C == comparison::not_equal);
+         }
+
+         template <class T>
+         inline __m128i cmpeq(__m128i a, __m128i b) {
+            if constexpr (sizeof(T) == 1) return _mm_cmpeq_epi8(a, b);
+            else if constexpr (sizeof(T) == 2) return _mm_cmpeq_epi16(a, b);
+            else if constexpr (sizeof(T) == 4) return _mm_cmpeq_epi32(a, b);
+            else {
+               //A 64-bit lane is equal if both of its 32-bit halves are
+               auto halves = _mm_cmpeq_epi32(a, b);
+               return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+         }
+
+         template <class T>
+         inline __m128i cmpgt(__m128i a, __m128i b) {
+            if constexpr (std::is_unsigned_v<T>) {
+               //Flip the sign bits so that a signed comparison gives the unsigned ordering
+               auto bias = [] {
+                  if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(0x80));
+                  else if constexpr (sizeof(T) == 2) return _mm_set1_epi16(static_cast<short>(0x8000));
+                  else return _mm_set1_epi32(static_cast<int>(0x80000000u));
+               }();
+               a = _mm_xor_si128(a, bias);
+               b = _mm_xor_si128(b, bias);
+            }
+            if constexpr (sizeof(T) == 1) return _mm_cmpgt_epi8(a, b);
+            else if constexpr (sizeof(T) == 2) return _mm_cmpgt_epi16(a, b);
+            else return _mm_cmpgt_epi32(a, b);
+         }
+
+         inline __m128i bitwise_not(__m128i a) {
+            return _mm_xor_si128(a, _mm_set1_epi32(-1));
+         }
+
+         //Returns a mask with one bit per byte (integers) or per lane (floating point) which is set
+         //where the comparison holds for the pair (p[i], p[i+1])
+         template <class T, comparison C>
+         inline unsigned pairs_holding(T const* p) {
+            if constexpr (std::same_as<T, float>) {
+               auto a = _mm_loadu_ps(p);
+               auto b = _mm_loadu_ps(p + 1);
+               if constexpr (C == comparison::equal) return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+               else if constexpr (C == comparison::not_equal) return _mm_movemask_ps(_mm_cmpneq_ps(a, b));
+               else if constexpr (C == comparison::less) return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+               else if constexpr (C == comparison::greater) return _mm_movemask_ps(_mm_cmpgt_ps(a, b));
+               else if constexpr (C == comparison::less_equal) return _mm_movemask_ps(_mm_cmple_ps(a, b));
+               else return _mm_movemask_ps(_mm_cmpge_ps(a, b));
+            }
+            else if constexpr (std::same_as<T, double>) {
+               auto a = _mm_loadu_pd(p);
+               auto b = _mm_loadu_pd(p + 1);
+               if constexpr (C == comparison::equal) return _mm_movemask_pd(_mm_cmpeq_pd(a, b));
+               else if constexpr (C == comparison::not_equal) return _mm_movemask_pd(_mm_cmpneq_pd(a, b));
+               else if constexpr (C == comparison::less) return _mm_movemask_pd(_mm_cmplt_pd(a, b));
+               else if constexpr (C == comparison::greater) return _mm_movemask_pd(_mm_cmpgt_pd(a, b));
+               else if constexpr (C == comparison::less_equal) return _mm_movemask_pd(_mm_cmple_pd(a, b));
+               else return _mm_movemask_pd(_mm_cmpge_pd(a, b));
+            }
+            else {
+               auto a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+               auto b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 1));
+               if constexpr (C == comparison::equal) return _mm_movemask_epi8(cmpeq<T>(a, b));
+               else if constexpr (C == comparison::not_equal) return _mm_movemask_epi8(bitwise_not(cmpeq<T>(a, b)));
+               else if constexpr (C == comparison::less) return _mm_movemask_epi8(cmpgt<T>(b, a));
+               else if constexpr (C == comparison::greater) return _mm_movemask_epi8(cmpgt<T>(a, b));
+               else if constexpr (C == comparison::less_equal) return _mm_movemask_epi8(bitwise_not(cmpgt<T>(a, b)));
+               else return _mm_movemask_epi8(bitwise_not(cmpgt<T>(b, a)));
+            }
+         }
+
+         template <class T, comparison C>
+         std::ptrdiff_t find_adjacent_mismatch(T const* data, std::ptrdiff_t n) {
+            constexpr std::ptrdiff_t lanes = 16 / sizeof(T);
+            //Bits per lane in the mask returned by pairs_holding
+            constexpr unsigned lane_bits = std::floating_point<T> ? 1 : sizeof(T);
+            constexpr unsigned all_holding = (1u << (lanes * lane_bits)) - 1;
+
+            std::ptrdiff_t i = 0;
+            //Every pair (i, i+1) in the register must be in range, so stop when fewer than lanes+1 elements remain
+            for (; i + lanes < n; i += lanes) {
+               auto holding = pairs_holding<T, C>(data + i);
+               if (holding != all_holding) {
+                  return i + std::countr_one(holding) / lane_bits;
+               }
+            }
+            return i;
+         }
+      }
+#endif
+
+      template <std::forward_iterator I, std::sentinel_for<I> S, class F>
+      constexpr I find_adjacent_mismatch(I first, S last, F& pred) {
+#ifdef TL_RANGES_SSE2
+         using T = std::iter_value_t<I>;
+         constexpr auto C = comparison_for<std::remove_cvref_t<F>, T>();
+         if constexpr (std::contiguous_iterator<I> && std::sized_sentinel_for<S, I> && sse2::supported<T, C>()) {
+            if (!std::is_constant_evaluated()) {
+               //If the vectorised search stopped early then this is the mismatch, otherwise the scalar search finishes off the last few pairs
+               first += sse2::find_adjacent_mismatch<T, C>(std::to_address(first), last - first);
+            }
+         }
+#endif
+         return std::ranges::adjacent_find(std::move(first), std::move(last), std::not_fn(std::ref(pred)));
+      }
+   }
+}
+
+#endif
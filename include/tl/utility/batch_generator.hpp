@@ -0,0 +1,81 @@
+#ifndef TL_RANGES_UTILITY_BATCH_GENERATOR_HPP
+#define TL_RANGES_UTILITY_BATCH_GENERATOR_HPP
+
+//A generator for tl::views::generate and tl::views::generate_n can opt in to producing values in bulk by providing
+//g.fill(span) as well as g(). fill must write out.size() values, the same as calling g() that many times, e.g.
+//
+//struct random_floats {
+//   float operator()();
+//   void fill(std::span<float> out); //Vectorised
+//};
+//
+//The views then call fill for blocks of values and hand them out one at a time, rather than calling g() for every
+//element, and tl::to fills containers with a single call. For tl::views::generate, which is unbounded, this means
+//values are generated up to a block ahead of the ones which have been read.
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace tl {
+   template <class G>
+   concept batch_generator = std::invocable<G&> &&
+      std::default_initializable<std::remove_cvref_t<std::invoke_result_t<G&>>> &&
+      requires(G& g, std::span<std::remove_cvref_t<std::invoke_result_t<G&>>> out) {
+         g.fill(out);
+      };
+
+   namespace detail {
+      //Values which have been generated in bulk but not handed out yet
+      template <class T>
+      class generation_buffer {
+         std::vector<T> values_;
+         std::size_t index_ = 0;
+
+         template <class G>
+         void refill(G& g, std::size_t limit) {
+            constexpr std::size_t block = std::max<std::size_t>(4096 / sizeof(T), 16);
+            values_.resize(std::min(block, limit));
+            g.fill(std::span<T>(values_));
+            index_ = 0;
+         }
+
+      public:
+         //The current value. limit is the most values which may be generated.
+         template <class G>
+         T& current(G& g, std::size_t limit) {
+            if (index_ == values_.size()) refill(g, limit);
+            return values_[index_];
+         }
+
+         template <class G>
+         void next(G& g, std::size_t limit) {
+            if (index_ == values_.size()) refill(g, limit);
+            ++index_;
+         }
+
+         //Writes the next out.size() values to out, starting with any which are buffered
+         template <class G>
+         void copy_to(G& g, std::span<T> out) {
+            auto buffered = std::min(values_.size() - index_, out.size());
+            auto out_it = std::ranges::move(values_.begin() + index_, values_.begin() + index_ + buffered, out.begin()).out;
+            index_ += buffered;
+            if (buffered != out.size()) {
+               g.fill(std::span<T>(out_it, out.end()));
+            }
+         }
+      };
+
+      struct no_generation_buffer {};
+
+      template <class F>
+      using generation_buffer_for = std::conditional_t<batch_generator<F>,
+         generation_buffer<std::remove_cvref_t<std::invoke_result_t<F&>>>, no_generation_buffer>;
+   }
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef TL_RANGES_UTILITY_FLAT_HASH_MAP_HPP
+#define TL_RANGES_UTILITY_FLAT_HASH_MAP_HPP
+
+//tl::flat_hash_map is an open-addressing hash map which stores its elements
+//inline in a single array and resolves collisions with linear probing, so
+//lookups touch consecutive memory rather than chasing node pointers like
+//std::unordered_map does.
+//
+//Differences from std::unordered_map:
+//- value_type is std::pair<Key, T> rather than std::pair<const Key, T>. Don't modify keys through iterators.
+//- Inserting or erasing invalidates all iterators and references.
+//- There are no buckets or local iterators.
+//
+//tl::flat_hash_set is the set version, on the same table.
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "../basic_iterator.hpp"
+
+namespace tl {
+   namespace detail {
+      //The table behind flat_hash_map. KeyOf extracts the key from a stored Value.
+      template <class Value, class Key, class KeyOf, class Hash, class KeyEqual>
+      class open_addressing_table {
+      protected:
+         std::vector<std::optional<Value>> slots_;
+         std::size_t size_ = 0;
+         //log2 of the number of slots
+         unsigned shift_bits_ = 0;
+         [[no_unique_address]] Hash hash_;
+         [[no_unique_address]] KeyEqual equal_;
+         [[no_unique_address]] KeyOf key_of_;
+
+         //Keep the load factor at or below 3/4. Probe sequences get long quickly beyond that.
+         static constexpr std::size_t max_load(std::size_t slots) {
+            return slots - slots / 4;
+         }
+
+         //std::hash is the identity for integers on common implementations, so scramble the bits with
+         //Fibonacci hashing before taking the top bits. Otherwise keys with the same low bits all collide.
+         std::size_t home_slot(Key const& key) const {
+            auto h = static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(h >> (64 - shift_bits_));
+         }
+
+         std::size_t mask() const {
+            return slots_.size() - 1;
+         }
+
+         //Index of the slot which holds key, or of the empty slot where it would be inserted
+         std::size_t find_slot(Key const& key) const {
+            auto i = home_slot(key);
+            while (slots_[i] && !equal_(key_of_(*slots_[i]), key)) {
+               i = (i + 1) & mask();
+            }
+            return i;
+         }
+
+         void rehash(std::size_t slot_count) {
+            unsigned bits = 1;
+            while ((std::size_t(1) << bits) < slot_count) ++bits;
+
+            auto old = std::exchange(slots_, std::vector<std::optional<Value>>(std::size_t(1) << bits));
+            shift_bits_ = bits;
+            for (auto& slot : old) {
+               if (slot) {
+                  slots_[find_slot(key_of_(*slot))].emplace(std::move(*slot));
+               }
+            }
+         }
+
+         //Returns the slot for key and whether it was inserted. make() is only called if it needs to be.
+         template <class Make>
+         std::pair<std::size_t, bool> find_or_insert(Key const& key, Make&& make) {
+            if (slots_.empty()) rehash(16);
+
+            auto i = find_slot(key);
+            if (slots_[i]) return { i, false };
+
+            if (size_ + 1 > max_load(slots_.size())) {
+               rehash(slots_.size() * 2);
+               i = find_slot(key);
+            }
+            slots_[i].emplace(make());
+            ++size_;
+            return { i, true };
+         }
+
+         //Backward-shift deletion: move later elements of the probe sequence into the hole so that lookups
+         //never need tombstones.
+         void erase_slot(std::size_t hole) {
+            slots_[hole].reset();
+            --size_;
+            for (auto i = (hole + 1) & mask(); slots_[i]; i = (i + 1) & mask()) {
+               auto home = home_slot(key_of_(*slots_[i]));
+               //The element at i can fill the hole if the hole is between its home slot and i
+               if (((i - home) & mask()) >= ((i - hole) & mask())) {
+                  slots_[hole].emplace(std::move(*slots_[i]));
+                  slots_[i].reset();
+                  hole = i;
+               }
+            }
+         }
+
+         template <bool Const>
+         class cursor {
+            using Slots = std::conditional_t<Const, std::vector<std::optional<Value>> const, std::vector<std::optional<Value>>>;
+            Slots* slots_ = nullptr;
+            std::size_t index_ = 0;
+
+            void skip_empty() {
+               while (index_ < slots_->size() && !(*slots_)[index_]) ++index_;
+            }
+
+         public:
+            cursor() = default;
+            cursor(Slots* slots, std::size_t index) : slots_(slots), index_(index) {
+               skip_empty();
+            }
+
+            cursor(cursor<!Const> c) requires Const
+               : slots_(c.slots_), index_(c.index_) {}
+
+            std::conditional_t<Const, Value const&, Value&> read() const {
+               return *(*slots_)[index_];
+            }
+
+            void next() {
+               ++index_;
+               skip_empty();
+            }
+
+            bool equal(cursor const& rhs) const {
+               return index_ == rhs.index_;
+            }
+
+            friend class cursor<!Const>;
+         };
+
+      public:
+         using key_type = Key;
+         using value_type = Value;
+         using size_type = std::size_t;
+         using hasher = Hash;
+         using key_equal = KeyEqual;
+         using iterator = basic_iterator<cursor<false>>;
+         using const_iterator = basic_iterator<cursor<true>>;
+
+         open_addressing_table() = default;
+         explicit open_addressing_table(std::size_t capacity, Hash hash = Hash(), KeyEqual equal = KeyEqual())
+            : hash_(std::move(hash)), equal_(std::move(equal)) {
+            reserve(capacity);
+         }
+
+         iterator begin() { return iterator{ cursor<false>(&slots_, 0) }; }
+         iterator end() { return iterator{ cursor<false>(&slots_, slots_.size()) }; }
+         const_iterator begin() const { return const_iterator{ cursor<true>(&slots_, 0) }; }
+         const_iterator end() const { return const_iterator{ cursor<true>(&slots_, slots_.size()) }; }
+
+         std::size_t size() const { return size_; }
+         bool empty() const { return size_ == 0; }
+
+         //Make sure that inserting up to n elements in total won't rehash
+         void reserve(std::size_t n) {
+            auto slots = std::size_t(16);
+            while (max_load(slots) < n) slots *= 2;
+            if (slots > slots_.size()) rehash(slots);
+         }
+
+         void clear() {
+            for (auto& slot : slots_) slot.reset();
+            size_ = 0;
+         }
+
+         iterator find(Key const& key) {
+            if (empty()) return end();
+            auto i = find_slot(key);
+            return slots_[i] ? iterator{ cursor<false>(&slots_, i) } : end();
+         }
+         const_iterator find(Key const& key) const {
+            if (empty()) return end();
+            auto i = find_slot(key);
+            return slots_[i] ? const_iterator{ cursor<true>(&slots_, i) } : end();
+         }
+
+         bool contains(Key const& key) const {
+            return find(key) != end();
+         }
+
+         std::size_t erase(Key const& key) {
+            if (empty()) return 0;
+            auto i = find_slot(key);
+            if (!slots_[i]) return 0;
+            erase_slot(i);
+            return 1;
+         }
+      };
+
+      struct pair_first {
+         template <class P>
+         constexpr auto const& operator()(P const& p) const { return p.first; }
+      };
+
+      struct identity_key {
+         template <class K>
+         constexpr K const& operator()(K const& k) const { return k; }
+      };
+   }
+
+   template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+   class flat_hash_map : public detail::open_addressing_table<std::pair<Key, T>, Key, detail::pair_first, Hash, KeyEqual> {
+      using base = detail::open_addressing_table<std::pair<Key, T>, Key, detail::pair_first, Hash, KeyEqual>;
+
+   public:
+      using mapped_type = T;
+      using typename base::iterator;
+      using base::base;
+
+      template <class K = Key, class... Args>
+      std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+         auto [i, inserted] = this->find_or_insert(key, [&] {
+            return std::pair<Key, T>(std::piecewise_construct,
+               std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+         });
+         return { iterator{ typename base::template cursor<false>(&this->slots_, i) }, inserted };
+      }
+
+      std::pair<iterator, bool> insert(std::pair<Key, T> value) {
+         auto [i, inserted] = this->find_or_insert(value.first, [&] { return std::move(value); });
+         return { iterator{ typename base::template cursor<false>(&this->slots_, i) }, inserted };
+      }
+
+      T& operator[](Key const& key) requires std::default_initializable<T> {
+         return try_emplace(key).first->second;
+      }
+   };
+
+   //Don't modify elements through iterators
+   template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+   class flat_hash_set : public detail::open_addressing_table<Key, Key, detail::identity_key, Hash, KeyEqual> {
+      using base = detail::open_addressing_table<Key, Key, detail::identity_key, Hash, KeyEqual>;
+
+   public:
+      using typename base::iterator;
+      using base::base;
+
+      //key is only copied if it's inserted
+      std::pair<iterator, bool> insert(Key const& key) {
+         auto [i, inserted] = this->find_or_insert(key, [&] { return key; });
+         return { iterator{ typename base::template cursor<false>(&this->slots_, i) }, inserted };
+      }
+
+      std::pair<iterator, bool> insert(Key&& key) {
+         auto [i, inserted] = this->find_or_insert(key, [&] { return std::move(key); });
+         return { iterator{ typename base::template cursor<false>(&this->slots_, i) }, inserted };
+      }
+   };
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef TL_RANGES_UTILITY_LOSER_TREE_HPP
+#define TL_RANGES_UTILITY_LOSER_TREE_HPP
+
+//tl::detail::loser_tree is a tournament tree over k sources, identified by their indices 0..k-1, which keeps track of
+//which source comes first. It doesn't know anything about the sources themselves: build and replay take
+//beats(a, b), which says whether source a should come out before source b.
+//
+//Each internal node stores the loser of the match played there, and the overall winner is kept in node 0.
+//When the winner's source changes, replay() plays it back up the path to the root against the stored losers,
+//so finding the next winner takes ceil(log2(k)) calls to beats, rather than the 2*log2(k) of a binary heap.
+//
+//Indices is the storage for the k nodes, e.g. std::array<std::size_t, N> or std::vector<std::size_t>(k).
+
+#include <cstddef>
+#include <utility>
+
+namespace tl {
+   namespace detail {
+      template <class Indices>
+      class loser_tree {
+         Indices nodes_{};
+
+         //Leaves are nodes k..2k-1, and aren't stored
+         template <class Beats>
+         std::size_t build(std::size_t node, Beats& beats) {
+            auto k = nodes_.size();
+            if (node >= k) return node - k;
+            auto a = build(2 * node, beats);
+            auto b = build(2 * node + 1, beats);
+            if (beats(a, b)) {
+               nodes_[node] = b;
+               return a;
+            }
+            nodes_[node] = a;
+            return b;
+         }
+
+      public:
+         loser_tree() = default;
+         explicit loser_tree(Indices nodes) : nodes_(std::move(nodes)) {}
+
+         std::size_t size() const {
+            return nodes_.size();
+         }
+
+         std::size_t winner() const {
+            return nodes_[0];
+         }
+
+         //Plays the whole tournament
+         template <class Beats>
+         void build(Beats beats) {
+            if (nodes_.size() == 0) return;
+            nodes_[0] = build(1, beats);
+         }
+
+         //Finds the new winner after the current winner's source has changed
+         template <class Beats>
+         void replay(Beats beats) {
+            auto winner = nodes_[0];
+            for (auto node = (nodes_.size() + winner) / 2; node > 0; node /= 2) {
+               if (beats(nodes_[node], winner)) std::swap(nodes_[node], winner);
+            }
+            nodes_[0] = winner;
+         }
+      };
+   }
+}
+
+#endif
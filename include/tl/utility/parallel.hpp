@@ -0,0 +1,56 @@
+#ifndef TL_RANGES_UTILITY_PARALLEL_HPP
+#define TL_RANGES_UTILITY_PARALLEL_HPP
+
+//tl::par is the execution policy taken by the library's parallel algorithms, e.g.
+//tl::chunk_by_boundaries(tl::par, r, pred). Use tl::parallel_policy{ n } to cap the number of blocks which the work is
+//split into, and tl::parallel_policy{ .pool = &pool } to run on a particular tl::thread_pool rather than the default one.
+
+#include <algorithm>
+#include <cstddef>
+#include "thread_pool.hpp"
+
+namespace tl {
+   struct parallel_policy {
+      //Maximum number of threads to use, or 0 to use all of the pool's threads
+      std::size_t max_threads = 0;
+      //The pool to run on, or nullptr to use tl::thread_pool::default_pool()
+      thread_pool* pool = nullptr;
+   };
+
+   constexpr inline parallel_policy par{};
+
+   namespace detail {
+      inline thread_pool& pool_for(parallel_policy policy) {
+         return policy.pool ? *policy.pool : thread_pool::default_pool();
+      }
+
+      inline std::size_t thread_count(parallel_policy policy) {
+         if (policy.max_threads != 0) return policy.max_threads;
+         return pool_for(policy).size();
+      }
+
+      //How many blocks to split n items into so that each block has at least min_block items
+      inline std::size_t block_count(parallel_policy policy, std::size_t n, std::size_t min_block) {
+         return std::clamp<std::size_t>(n / std::max<std::size_t>(min_block, 1), 1, thread_count(policy));
+      }
+
+      //Splits [0, n) into the given number of contiguous blocks and calls f(block_index, first, last) for each one on the
+      //policy's pool. If any block throws, an exception is rethrown once all blocks are done.
+      template <class F>
+      void parallel_for_blocks(parallel_policy policy, std::size_t blocks, std::size_t n, F&& f) {
+         auto bounds = [&](std::size_t block) { return n * block / blocks; };
+         if (blocks <= 1) {
+            f(std::size_t(0), std::size_t(0), n);
+            return;
+         }
+
+         pool_for(policy).parallel_for(0, blocks, 1, [&](std::size_t first, std::size_t last) {
+            for (auto block = first; block != last; ++block) {
+               f(block, bounds(block), bounds(block + 1));
+            }
+         });
+      }
+   }
+}
+
+#endif
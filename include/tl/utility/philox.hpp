@@ -0,0 +1,77 @@
+#ifndef TL_RANGES_UTILITY_PHILOX_HPP
+#define TL_RANGES_UTILITY_PHILOX_HPP
+
+//tl::philox4x32 is the Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel random numbers:
+//as easy as 1, 2, 3", 2011). Rather than stepping some internal state, it's a keyed bijection from a 128-bit counter to
+//four random 32-bit words, so any position in the stream can be computed in O(1) and different threads can generate
+//disjoint parts of it without coordinating.
+//
+//tl::philox_engine adapts it to std::uniform_random_bit_generator, for use with the standard distributions. Its 128-bit
+//counter is split into a 64-bit stream number, fixed on construction, and a 64-bit position within that stream.
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace tl {
+   struct philox4x32 {
+      using counter_type = std::array<std::uint32_t, 4>;
+      using key_type = std::array<std::uint32_t, 2>;
+
+      static constexpr counter_type generate(counter_type counter, key_type key) {
+         for (int round = 0; round < 10; ++round) {
+            if (round != 0) {
+               key[0] += 0x9E3779B9;
+               key[1] += 0xBB67AE85;
+            }
+            auto product0 = std::uint64_t(0xD2511F53) * counter[0];
+            auto product1 = std::uint64_t(0xCD9E8D57) * counter[2];
+            counter = {
+               static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+               static_cast<std::uint32_t>(product1),
+               static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+               static_cast<std::uint32_t>(product0)
+            };
+         }
+         return counter;
+      }
+
+      static constexpr key_type key_for(std::uint64_t seed) {
+         return { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+      }
+   };
+
+   class philox_engine {
+      philox4x32::key_type key_{};
+      philox4x32::counter_type counter_{};
+      philox4x32::counter_type block_{};
+      unsigned used_ = 4;
+
+   public:
+      using result_type = std::uint32_t;
+
+      static constexpr result_type min() { return 0; }
+      static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+      constexpr philox_engine() = default;
+      constexpr explicit philox_engine(std::uint64_t seed, std::uint64_t stream = 0)
+         : philox_engine(philox4x32::key_for(seed), stream) {}
+      constexpr philox_engine(philox4x32::key_type key, std::uint64_t stream)
+         : key_(key), counter_{ static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32), 0, 0 } {}
+
+      constexpr result_type operator()() {
+         if (used_ == 4) {
+            block_ = philox4x32::generate(counter_, key_);
+            used_ = 0;
+            if (++counter_[2] == 0) ++counter_[3];
+         }
+         return block_[used_++];
+      }
+
+      constexpr void discard(unsigned long long n) {
+         for (; n != 0; --n) (*this)();
+      }
+   };
+}
+
+#endif
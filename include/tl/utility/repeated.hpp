@@ -0,0 +1,59 @@
+#ifndef TL_RANGES_UTILITY_REPEATED_HPP
+#define TL_RANGES_UTILITY_REPEATED_HPP
+
+//tl::detail::repeated_range recognises ranges which are known to be a single value repeated a finite number of times:
+//tl::repeat_n_view, and std::ranges::take_view of tl::repeat_view or tl::repeat_n_view.
+//tl::to and tl::fold_left use it to build containers with C(n, value) and to fold in closed form rather than
+//visiting every element.
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <type_traits>
+#include "../repeat.hpp"
+#include "../repeat_n.hpp"
+
+namespace tl {
+   namespace detail {
+      template <class V>
+      constexpr inline bool is_repeat_view = false;
+      template <class T>
+      constexpr inline bool is_repeat_view<repeat_view<T>> = true;
+      template <class T>
+      constexpr inline bool is_repeat_view<repeat_n_view<T>> = true;
+
+      template <class R>
+      constexpr inline bool is_repeated_range = false;
+      template <class T>
+      constexpr inline bool is_repeated_range<repeat_n_view<T>> = true;
+      template <class V>
+      constexpr inline bool is_repeated_range<std::ranges::take_view<V>> = is_repeat_view<V>;
+
+      template <class R>
+      concept repeated_range = is_repeated_range<std::remove_cvref_t<R>>;
+
+      template <repeated_range R>
+      constexpr decltype(auto) repeated_value(R const& r) {
+         if constexpr (requires { r.value(); }) {
+            return r.value();
+         }
+         else {
+            //Refers to the value stored in the underlying view. Dereferencing is fine even if the count is 0.
+            return *std::ranges::begin(r);
+         }
+      }
+
+      template <repeated_range R>
+      constexpr std::size_t repeated_count(R&& r) {
+         if constexpr (std::ranges::sized_range<R>) {
+            return static_cast<std::size_t>(std::ranges::size(r));
+         }
+         else {
+            //take_view of an unbounded range hands out counted_iterators
+            return static_cast<std::size_t>(std::ranges::begin(r).count());
+         }
+      }
+   }
+}
+
+#endif
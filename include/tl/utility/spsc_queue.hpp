@@ -0,0 +1,112 @@
+#ifndef TL_RANGES_UTILITY_SPSC_QUEUE_HPP
+#define TL_RANGES_UTILITY_SPSC_QUEUE_HPP
+
+//tl::spsc_queue is a bounded single-producer single-consumer queue backed by a ring buffer.
+//Pushing and popping are lock-free. When the queue is full the producer blocks, and when it's empty the consumer blocks,
+//using std::atomic::wait on the index which the other side will update.
+//
+//Either side can close the queue: the producer calls finish() once it has nothing left to push, after which the consumer
+//sees the remaining elements and then front() returns nullptr. The consumer calls close() if it's no longer interested,
+//after which push() returns false once the queue has filled up.
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace tl {
+   template <class T>
+   class spsc_queue {
+      //The top bit of each index is used as a flag which the owning side sets to close the queue
+      static constexpr std::size_t closed_bit = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 1);
+
+      static std::size_t round_up_capacity(std::size_t n) {
+         std::size_t capacity = 1;
+         while (capacity < n) capacity *= 2;
+         return capacity;
+      }
+
+      std::vector<std::optional<T>> slots_;
+      std::size_t mask_;
+
+      //Keep the indices on separate cache lines so that the producer and consumer don't contend for them.
+      //Each side keeps a copy of the other's index and only reloads it when the queue looks full or empty.
+      alignas(64) std::atomic<std::size_t> head_ = 0;
+      std::size_t cached_tail_ = 0;
+      alignas(64) std::atomic<std::size_t> tail_ = 0;
+      std::size_t cached_head_ = 0;
+
+   public:
+      //capacity is rounded up to a power of two
+      explicit spsc_queue(std::size_t capacity)
+         : slots_(round_up_capacity(capacity)), mask_(slots_.size() - 1) {}
+
+      spsc_queue(spsc_queue const&) = delete;
+      spsc_queue& operator=(spsc_queue const&) = delete;
+
+      std::size_t capacity() const {
+         return slots_.size();
+      }
+
+      //Producer side. Blocks while the queue is full, and returns false without pushing if the consumer has closed it.
+      template <class U>
+      bool push(U&& value) {
+         auto tail = tail_.load(std::memory_order_relaxed);
+         if (tail - cached_head_ == slots_.size()) {
+            while (true) {
+               auto head = head_.load(std::memory_order_acquire);
+               if (head & closed_bit) return false;
+               if (head != cached_head_) {
+                  cached_head_ = head;
+                  break;
+               }
+               head_.wait(head, std::memory_order_acquire);
+            }
+         }
+
+         slots_[tail & mask_].emplace(std::forward<U>(value));
+         tail_.store(tail + 1, std::memory_order_release);
+         tail_.notify_one();
+         return true;
+      }
+
+      //Producer side. Signals that nothing more will be pushed.
+      void finish() {
+         tail_.fetch_or(closed_bit, std::memory_order_release);
+         tail_.notify_one();
+      }
+
+      //Consumer side. Blocks until there's an element, and returns nullptr if the producer finished and the queue is empty.
+      T* front() {
+         auto head = head_.load(std::memory_order_relaxed);
+         while (cached_tail_ == head) {
+            auto tail = tail_.load(std::memory_order_acquire);
+            if ((tail & ~closed_bit) != head) {
+               cached_tail_ = tail & ~closed_bit;
+               break;
+            }
+            if (tail & closed_bit) return nullptr;
+            tail_.wait(tail, std::memory_order_acquire);
+         }
+         return &*slots_[head & mask_];
+      }
+
+      //Consumer side. Removes the element returned by front().
+      void pop() {
+         auto head = head_.load(std::memory_order_relaxed);
+         slots_[head & mask_].reset();
+         head_.store(head + 1, std::memory_order_release);
+         head_.notify_one();
+      }
+
+      //Consumer side. Signals that nothing more will be popped, so the producer can stop.
+      void close() {
+         head_.fetch_or(closed_bit, std::memory_order_release);
+         head_.notify_one();
+      }
+   };
+}
+
+#endif
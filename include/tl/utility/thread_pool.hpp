@@ -0,0 +1,304 @@
+#ifndef TL_RANGES_UTILITY_THREAD_POOL_HPP
+#define TL_RANGES_UTILITY_THREAD_POOL_HPP
+
+//tl::thread_pool is a work-stealing pool of worker threads which backs the library's parallel algorithms and views.
+//
+//Each worker has its own deque of tasks. Tasks spawned from a worker go on the back of its own deque and it takes
+//work from the back, so nested parallelism runs depth-first and stays cache-warm. Idle workers steal from the front
+//of other workers' deques, which is where the largest pieces of a recursively split job end up. Tasks submitted from
+//other threads go on a shared queue which all workers take from.
+//
+//pool.parallel_for(first, last, grain, f) is a fork/join loop: it calls f(sub_first, sub_last) on subranges of
+//[first, last) no bigger than grain, recursively splitting the range so that idle workers can steal halves of it.
+//The calling thread runs tasks while it waits, so parallel_for can be nested, or called from inside a task,
+//without oversubscribing the machine or deadlocking.
+//
+//There's no global pool unless you ask for one: tl::thread_pool::default_pool() is created on first use with one thread
+//per hardware thread, and is what tl::par uses unless it's given a pool with tl::parallel_policy{ .pool = &pool }.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tl {
+   namespace detail {
+      //A move-only type-erased nullary function
+      class pool_task {
+         struct base {
+            virtual ~base() = default;
+            virtual void run() = 0;
+         };
+         template <class F>
+         struct impl : base {
+            F f_;
+            impl(F f) : f_(std::move(f)) {}
+            void run() override { f_(); }
+         };
+         std::unique_ptr<base> task_;
+
+      public:
+         pool_task() = default;
+         template <class F>
+         requires (!std::same_as<std::remove_cvref_t<F>, pool_task>)
+         pool_task(F&& f) : task_(std::make_unique<impl<std::decay_t<F>>>(std::forward<F>(f))) {}
+
+         void operator()() {
+            task_->run();
+         }
+      };
+   }
+
+   class thread_pool {
+      struct task_queue {
+         std::mutex mutex_;
+         std::deque<detail::pool_task> tasks_;
+      };
+
+      struct worker_context {
+         thread_pool* pool;
+         std::size_t index;
+      };
+      //Zero-initialized, so threads start out not belonging to any pool
+      static inline thread_local worker_context current_;
+
+      //One queue per worker, plus one at the end for tasks from other threads
+      std::unique_ptr<task_queue[]> queues_;
+      std::size_t thread_count_;
+      //Number of tasks in all of the queues, used to decide whether workers can go to sleep
+      std::atomic<std::size_t> queued_ = 0;
+      std::atomic<std::size_t> sleepers_ = 0;
+      std::mutex sleep_mutex_;
+      std::condition_variable wake_;
+      bool stopping_ = false;
+      //Declared last so that the workers are joined before the queues are destroyed
+      std::vector<std::jthread> workers_;
+
+      std::size_t external_queue() const {
+         return thread_count_;
+      }
+
+      //The queue which the current thread pushes to and pops from first
+      std::size_t own_queue() const {
+         return current_.pool == this ? current_.index : external_queue();
+      }
+
+      void push(detail::pool_task task) {
+         auto& queue = queues_[own_queue()];
+         {
+            std::scoped_lock lock(queue.mutex_);
+            queue.tasks_.push_back(std::move(task));
+         }
+         queued_.fetch_add(1);
+         //Sleepers check queued_ after registering themselves, so one of us will see the other's update
+         if (sleepers_.load() > 0) {
+            std::scoped_lock lock(sleep_mutex_);
+            wake_.notify_one();
+         }
+      }
+
+      bool try_pop(detail::pool_task& task) {
+         auto own = own_queue();
+         //Workers take their own newest task. The shared queue is FIFO.
+         {
+            auto& queue = queues_[own];
+            std::scoped_lock lock(queue.mutex_);
+            if (!queue.tasks_.empty()) {
+               if (own == external_queue()) {
+                  task = std::move(queue.tasks_.front());
+                  queue.tasks_.pop_front();
+               }
+               else {
+                  task = std::move(queue.tasks_.back());
+                  queue.tasks_.pop_back();
+               }
+               queued_.fetch_sub(1);
+               return true;
+            }
+         }
+         //Otherwise steal the oldest task from someone else
+         for (std::size_t i = 1; i <= thread_count_; ++i) {
+            auto& queue = queues_[(own + i) % (thread_count_ + 1)];
+            std::scoped_lock lock(queue.mutex_);
+            if (!queue.tasks_.empty()) {
+               task = std::move(queue.tasks_.front());
+               queue.tasks_.pop_front();
+               queued_.fetch_sub(1);
+               return true;
+            }
+         }
+         return false;
+      }
+
+      void work(std::size_t index) {
+         current_ = { this, index };
+         detail::pool_task task;
+         while (true) {
+            if (try_pop(task)) {
+               task();
+               task = {};
+               continue;
+            }
+
+            std::unique_lock lock(sleep_mutex_);
+            if (stopping_ && queued_.load() == 0) break;
+            sleepers_.fetch_add(1);
+            wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+            sleepers_.fetch_sub(1);
+         }
+         current_ = { nullptr, 0 };
+      }
+
+      //The shared state of one parallel_for call
+      template <class F>
+      struct fork_join {
+         thread_pool* pool_;
+         F* f_;
+         std::size_t grain_;
+         std::mutex mutex_;
+         std::condition_variable done_;
+         std::size_t pending_ = 0;
+         std::exception_ptr error_;
+
+         fork_join(thread_pool* pool, F* f, std::size_t grain) : pool_(pool), f_(f), grain_(grain) {}
+
+         void fail() {
+            std::scoped_lock lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+         }
+
+         //Hand off the top half of the range until what's left is small enough, then do that
+         void run(std::size_t first, std::size_t last) {
+            while (last - first > grain_) {
+               auto mid = first + (last - first) / 2;
+               {
+                  std::scoped_lock lock(mutex_);
+                  ++pending_;
+               }
+               pool_->push([this, mid, last] {
+                  try {
+                     run(mid, last);
+                  }
+                  catch (...) {
+                     fail();
+                  }
+                  //Notify while holding the lock so that the waiting thread can't destroy this first
+                  std::scoped_lock lock(mutex_);
+                  if (--pending_ == 0) done_.notify_all();
+               });
+               last = mid;
+            }
+            (*f_)(first, last);
+         }
+
+         void wait() {
+            //Help with whatever's queued. Once there's nothing left to take, every task this is waiting for is
+            //already running on some other thread, so it's safe to block.
+            while (pool_->run_pending_task()) {
+               std::scoped_lock lock(mutex_);
+               if (pending_ == 0) return;
+            }
+            std::unique_lock lock(mutex_);
+            done_.wait(lock, [this] { return pending_ == 0; });
+         }
+      };
+
+   public:
+      //threads == 0 means one thread per hardware thread
+      explicit thread_pool(std::size_t threads = 0)
+         : thread_count_(threads != 0 ? threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1)) {
+         queues_ = std::make_unique<task_queue[]>(thread_count_ + 1);
+         workers_.reserve(thread_count_);
+         for (std::size_t i = 0; i < thread_count_; ++i) {
+            workers_.emplace_back([this, i] { work(i); });
+         }
+      }
+
+      thread_pool(thread_pool const&) = delete;
+      thread_pool& operator=(thread_pool const&) = delete;
+
+      //Runs any tasks which are still queued, then joins the workers
+      ~thread_pool() {
+         {
+            std::scoped_lock lock(sleep_mutex_);
+            stopping_ = true;
+         }
+         wake_.notify_all();
+      }
+
+      static thread_pool& default_pool() {
+         static thread_pool pool;
+         return pool;
+      }
+
+      std::size_t size() const {
+         return thread_count_;
+      }
+
+      //Whether the calling thread is one of this pool's workers
+      bool in_worker() const {
+         return current_.pool == this;
+      }
+
+      //Runs one queued task on the calling thread, if there is one. Returns whether it did.
+      bool run_pending_task() {
+         detail::pool_task task;
+         if (!try_pop(task)) return false;
+         task();
+         return true;
+      }
+
+      //Queues f to run on a worker thread. Exceptions thrown by f are stored in the returned future.
+      template <class F>
+      requires std::invocable<std::decay_t<F>&>
+      auto submit(F&& f) {
+         using result_type = std::invoke_result_t<std::decay_t<F>&>;
+         std::packaged_task<result_type()> task(std::forward<F>(f));
+         auto future = task.get_future();
+         push([task = std::move(task)]() mutable { task(); });
+         return future;
+      }
+
+      //Waits for future to be ready. If called from a worker, runs other tasks in the meantime so that the pool
+      //can't deadlock with every worker waiting.
+      template <class T>
+      void wait(std::future<T> const& future) {
+         if (in_worker()) {
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+               if (!run_pending_task()) std::this_thread::yield();
+            }
+         }
+         future.wait();
+      }
+
+      //Calls f(sub_first, sub_last) for subranges of [first, last) of at most grain indices, in parallel, and returns
+      //once they're all done. If any call throws, one of the exceptions is rethrown.
+      template <class F>
+      requires std::invocable<F&, std::size_t, std::size_t>
+      void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& f) {
+         if (first >= last) return;
+         fork_join<std::remove_reference_t<F>> job{ this, std::addressof(f), std::max<std::size_t>(grain, 1) };
+         try {
+            job.run(first, last);
+         }
+         catch (...) {
+            job.fail();
+         }
+         job.wait();
+         if (job.error_) std::rethrow_exception(job.error_);
+      }
+   };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include "tl/bernoulli.hpp"
+#include "tl/generate.hpp"
+
+TEST_CASE("bernoulli") {
+   std::mt19937 rng(42);
+   std::vector<int> v(100000);
+   std::iota(v.begin(), v.end(), 0);
+
+   std::vector<int> kept;
+   for (auto i : v | tl::views::bernoulli(0.1, rng)) kept.push_back(i);
+   REQUIRE(kept.size() > 9500);
+   REQUIRE(kept.size() < 10500);
+   REQUIRE(std::ranges::is_sorted(kept));
+   REQUIRE(std::ranges::adjacent_find(kept) == kept.end());
+
+   std::size_t all = 0;
+   for ([[maybe_unused]] auto i : tl::views::bernoulli(v, 1.0, rng)) ++all;
+   REQUIRE(all == v.size());
+
+   auto none = v | tl::views::bernoulli(0.0, rng);
+   REQUIRE(none.begin() == none.end());
+}
+
+TEST_CASE("bernoulli over an unbounded stream") {
+   std::mt19937 rng(7);
+   int n = 0;
+   auto stream = tl::views::generate([&n] { return n++; });
+   std::vector<int> kept;
+   for (auto i : stream | tl::views::bernoulli(0.5, rng)) {
+      kept.push_back(i);
+      if (kept.size() == 100) break;
+   }
+   REQUIRE(std::ranges::is_sorted(kept));
+   REQUIRE(kept.back() > 150);
+   REQUIRE(kept.back() < 300);
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ranges>
+#include "tl/cache_all.hpp"
+#include "tl/fold.hpp"
+#include "tl/generate.hpp"
+#include "tl/getlines.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("cache all getlines") {
+   std::stringstream ss("3\n1\n4\n1\n5");
+   auto numbers = tl::views::getlines(ss)
+      | std::views::transform([](std::string const& s) { return std::stod(s); })
+      | tl::views::cache_all;
+   static_assert(std::ranges::random_access_range<decltype(numbers)>);
+
+   //Two passes over a single-pass source
+   auto n = static_cast<double>(std::ranges::distance(numbers));
+   auto mean = tl::fold_left(numbers, 0.0, std::plus()) / n;
+   auto squares = numbers | std::views::transform([=](double x) { return (x - mean) * (x - mean); });
+   auto variance = tl::fold_left(squares, 0.0, std::plus()) / n;
+   REQUIRE(n == 5);
+   REQUIRE(mean == Approx(2.8));
+   REQUIRE(variance == Approx(2.56));
+}
+
+TEST_CASE("cache all evaluates once") {
+   std::vector<int> a{ 0, 1, 2, 3, 4 };
+   int calls = 0;
+   auto r = a | tl::views::weaken<tl::weakening::input>
+      | std::views::transform([&calls](int i) { ++calls; return i * i; })
+      | tl::views::cache_all;
+
+   auto it = r.begin();
+   REQUIRE(it[3] == 9);
+   REQUIRE(calls == 4);
+   REQUIRE(r.cached() == 4);
+
+   //Copies share the cache
+   auto copy = r;
+   REQUIRE(std::ranges::equal(copy, std::vector<int>{ 0, 1, 4, 9, 16 }));
+   REQUIRE(std::ranges::equal(r, std::vector<int>{ 0, 1, 4, 9, 16 }));
+   REQUIRE(calls == 5);
+
+   //References stay valid as more elements are pulled
+   std::stringstream ss("a\nb");
+   auto lines = tl::views::getlines(ss) | tl::views::cache_all;
+   auto& first = *lines.begin();
+   REQUIRE(std::ranges::distance(lines) == 2);
+   REQUIRE(first == "a");
+   REQUIRE(&first == &*lines.begin());
+}
+
+TEST_CASE("cache all sized") {
+   std::vector<int> a{ 1, 2, 3 };
+   auto r = a | tl::views::cache_all;
+   static_assert(std::ranges::common_range<decltype(r)>);
+   REQUIRE(r.size() == 3);
+   REQUIRE(r.cached() == 0);
+   REQUIRE(*(r.end() - 1) == 3);
+   REQUIRE(r.cached() == 3);
+}
+
+TEST_CASE("cache all unbounded") {
+   int i = 0;
+   auto r = tl::views::generate([&i] { return i++; }) | tl::views::cache_all;
+   REQUIRE(std::ranges::equal(r | std::views::take(4), std::vector<int>{ 0, 1, 2, 3 }));
+   REQUIRE(std::ranges::equal(r | std::views::take(6), std::vector<int>{ 0, 1, 2, 3, 4, 5 }));
+   REQUIRE(i == 6);
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ranges>
+#include "tl/cache_window.hpp"
+
+TEST_CASE("cache window") {
+   std::vector<int> a{ 0, 1, 2, 3, 4, 5 };
+   int calls = 0;
+   auto r = a | std::views::transform([&calls](int i) { ++calls; return i * 10; }) | tl::views::cache_window(3);
+   static_assert(std::ranges::input_range<decltype(r)>);
+
+   std::vector<int> seen;
+   for (auto it = r.begin(); it != r.end(); ++it) {
+      seen.push_back(*it);
+      seen.push_back(*it);
+   }
+   REQUIRE(seen == std::vector<int>{ 0, 0, 10, 10, 20, 20, 30, 30, 40, 40, 50, 50 });
+   REQUIRE(calls == 6);
+}
+
+TEST_CASE("cache window peek and backtrack") {
+   std::vector<int> a{ 0, 1, 2, 3, 4, 5 };
+   int calls = 0;
+   auto r = a | std::views::transform([&calls](int i) { ++calls; return i; }) | tl::views::cache_window(4);
+
+   auto it = r.begin();
+   REQUIRE(*it == 0);
+   REQUIRE(*r.peek(0) == 0);
+   REQUIRE(*r.peek(2) == 2);
+   REQUIRE(*r.peek(3) == 3);
+   REQUIRE(calls == 4);
+   REQUIRE(r.lookbehind() == 0);
+
+   ++it;
+   ++it;
+   REQUIRE(*it == 2);
+   REQUIRE(r.lookbehind() == 2);
+   r.backtrack(2);
+   REQUIRE(*it == 0);
+   ++it;
+   REQUIRE(*it == 1);
+   REQUIRE(calls == 4);
+
+   ++it;
+   ++it;
+   ++it;
+   REQUIRE(*it == 4);
+   REQUIRE(*r.peek(1) == 5);
+   REQUIRE(r.peek(2) == nullptr);
+   REQUIRE(calls == 6);
+   REQUIRE(r.lookbehind() == 2);
+
+   ++it;
+   ++it;
+   REQUIRE(it == r.end());
+}
+
+TEST_CASE("cache window unread elements") {
+   std::vector<int> a{ 0, 1, 2 };
+   int calls = 0;
+   auto r = a | std::views::transform([&calls](int i) { ++calls; return i; }) | tl::views::cache_window(2);
+   int count = 0;
+   for (auto it = r.begin(); it != r.end(); ++it) ++count;
+   REQUIRE(count == 3);
+   REQUIRE(calls == 3);
+}
+
+TEST_CASE("cache window lexer") {
+   //Splits "<<=" style operators greedily with one element of lookahead
+   std::string_view text = "a<=b<c==d";
+   auto chars = text | std::views::transform([](char c) { return c; }) | tl::views::cache_window(2);
+   std::vector<std::string> tokens;
+   for (auto it = chars.begin(); it != chars.end(); ++it) {
+      std::string token(1, *it);
+      auto next = chars.peek(1);
+      if ((*it == '<' || *it == '=') && next && *next == '=') {
+         token += *next;
+         ++it;
+      }
+      tokens.push_back(token);
+   }
+   REQUIRE(tokens == std::vector<std::string>{ "a", "<=", "b", "<", "c", "==", "d" });
+}
+
+TEST_CASE("cache window bools") {
+   std::vector<int> a{ 0,1,2,3,4,5 };
+   auto r = a | std::views::transform([](int i) { return i % 2 == 0; }) | tl::views::cache_window(2);
+   STATIC_REQUIRE(std::same_as<std::ranges::range_reference_t<decltype(r)>, bool&>);
+   std::vector<bool> out;
+   for (auto it = r.begin(); it != r.end(); ++it) {
+      bool* next = r.peek(1);
+      if (next) REQUIRE(*next == !*it);
+      out.push_back(*it);
+   }
+   REQUIRE(out == std::vector<bool>{ true, false, true, false, true, false });
+}
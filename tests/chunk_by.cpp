@@ -62,4 +62,24 @@ TEST_CASE("group_by pipe") {
       }
       group_id++;
    }
-}
\ No newline at end of file
+}
+
+TEST_CASE("group_by arithmetic") {
+   std::vector<int> v(50, 1);
+   v[17] = 2;
+   v[18] = 2;
+   v.push_back(3);
+
+   std::vector<std::size_t> sizes;
+   for (auto&& group : v | tl::views::chunk_by(std::equal_to<>{})) {
+      sizes.push_back(std::ranges::size(group));
+   }
+   REQUIRE(sizes == std::vector<std::size_t>{ 17, 2, 31, 1 });
+
+   std::vector<float> ascending{ 0, 1, 2, 3, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 1 };
+   sizes.clear();
+   for (auto&& group : ascending | tl::views::chunk_by(std::ranges::less{})) {
+      sizes.push_back(std::ranges::size(group));
+   }
+   REQUIRE(sizes == std::vector<std::size_t>{ 4, 18, 1 });
+}
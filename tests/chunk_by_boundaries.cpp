@@ -0,0 +1,50 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <functional>
+#include <ranges>
+#include "tl/chunk_by.hpp"
+#include "tl/chunk_by_boundaries.hpp"
+
+TEST_CASE("chunk_by_boundaries") {
+   std::vector<int> v{ 1, 1, 2, 3, 3, 3 };
+   auto offsets = tl::chunk_by_boundaries(v, std::equal_to<>{});
+   REQUIRE(offsets == std::vector<std::ptrdiff_t>{ 0, 2, 3, 6 });
+
+   std::vector<int> empty;
+   REQUIRE(tl::chunk_by_boundaries(empty, std::equal_to<>{}) == std::vector<std::ptrdiff_t>{ 0 });
+}
+
+TEST_CASE("chunk_by_boundaries parallel") {
+   std::vector<int> v;
+   for (int i = 0; i < 100000; ++i) {
+      v.push_back(i / 7 + (i % 1000 == 0));
+   }
+
+   auto serial = tl::chunk_by_boundaries(v, std::equal_to<>{});
+   auto parallel = tl::chunk_by_boundaries(tl::parallel_policy{ 4 }, v, std::equal_to<>{});
+   REQUIRE(serial == parallel);
+   REQUIRE(tl::chunk_by_boundaries(tl::par, v, [](int a, int b) { return a == b; }) == serial);
+}
+
+TEST_CASE("chunk_at") {
+   std::vector<int> v;
+   for (int i = 0; i < 50000; ++i) {
+      v.push_back(i / 3);
+   }
+
+   auto offsets = tl::chunk_by_boundaries(tl::par, v, std::equal_to<>{});
+   auto groups = v | tl::views::chunk_at(offsets);
+   STATIC_REQUIRE(std::ranges::random_access_range<decltype(groups)>);
+   STATIC_REQUIRE(std::ranges::sized_range<decltype(groups)>);
+
+   auto by = v | tl::views::chunk_by(std::equal_to<>{});
+   REQUIRE(std::ranges::size(groups) == static_cast<std::size_t>(std::ranges::distance(by)));
+   auto it = groups.begin();
+   for (auto&& group : by) {
+      REQUIRE(std::ranges::equal(group, *it));
+      ++it;
+   }
+
+   REQUIRE(std::ranges::equal(groups[4], std::vector{ 4, 4, 4 }));
+   REQUIRE(std::ranges::equal(*(groups.end() - 1), std::vector{ 16666, 16666 }));
+}
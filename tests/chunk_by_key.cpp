@@ -61,4 +61,49 @@ TEST_CASE("chunk_by_key pipe") {
     }
     group_id++;
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("chunk_by_key evaluates each key once") {
+   std::vector<int> v{ 1, 1, 2, 3, 3, 3, 4 };
+   int calls = 0;
+   auto key = [&calls](int i) { ++calls; return i; };
+
+   std::vector<int> keys;
+   for (auto&& [k, group] : v | tl::views::chunk_by_key(key)) {
+      keys.push_back(k);
+   }
+   REQUIRE(keys == std::vector{ 1, 2, 3, 4 });
+   REQUIRE(calls == 7);
+}
+
+TEST_CASE("cached_chunk_by_key") {
+   std::vector<dog> dogs{
+      {"fido", 12},
+      {"bob", 12},
+      {"katherine", 9},
+      {"max", 12},
+      {"sy", 12},
+   };
+   int calls = 0;
+   auto r = dogs | tl::views::cached_chunk_by_key([&calls](auto&& d) { ++calls; return d.age; });
+   STATIC_REQUIRE(std::ranges::forward_range<decltype(r)>);
+
+   for (int pass = 0; pass < 3; ++pass) {
+      std::vector<std::pair<int, std::size_t>> groups;
+      for (auto&& [key, group] : r) {
+         groups.emplace_back(key, std::ranges::size(group));
+      }
+      REQUIRE(groups == std::vector<std::pair<int, std::size_t>>{ {12, 2}, { 9, 1 }, { 12, 2 } });
+   }
+   REQUIRE(calls == 5);
+
+   auto&& [key, group] = *r.begin();
+   REQUIRE(&key == &(*r.begin()).first);
+   REQUIRE(group.begin()->name == "fido");
+}
+
+TEST_CASE("chunk_by_key empty") {
+   std::vector<int> v;
+   REQUIRE(std::ranges::empty(v | tl::views::chunk_by_key([](int i) { return i; })));
+   REQUIRE(std::ranges::empty(v | tl::views::cached_chunk_by_key([](int i) { return i; })));
+}
@@ -2,7 +2,10 @@
 #include <vector>
 #include <iostream>
 #include <list>
+#include <span>
+#include <ranges>
 #include "tl/cycle.hpp"
+#include "tl/to.hpp"
 
 TEST_CASE("cycle") {
    std::vector<int> a{ 0, 1, 2 };
@@ -35,4 +38,88 @@ TEST_CASE("random access") {
    REQUIRE(*it == 1);
    it -= 4;
    REQUIRE(*it == 1);
-}
\ No newline at end of file
+}
+TEST_CASE("random access distance") {
+   std::vector<int> a{ 0, 1, 2 };
+   auto cycle = a | tl::views::cycle;
+   auto it = std::ranges::begin(cycle);
+   auto later = it + 7;
+   REQUIRE(*later == 1);
+   REQUIRE(later - it == 7);
+   REQUIRE(it - later == -7);
+   REQUIRE(later != it + 1);
+   REQUIRE(it[5] == 2);
+   REQUIRE(*(it - 1) == 2);
+   REQUIRE(*(it - 7) == 2);
+   static_assert(std::ranges::random_access_range<decltype(cycle)>);
+}
+
+TEST_CASE("cycle_n") {
+   std::vector<int> a{ 0, 1, 2 };
+   auto cycle = a | tl::views::cycle_n(4);
+   static_assert(std::ranges::random_access_range<decltype(cycle)>);
+   static_assert(std::ranges::common_range<decltype(cycle)>);
+   REQUIRE(cycle.size() == 12);
+   REQUIRE(std::ranges::distance(cycle) == 12);
+   int i = 0;
+   for (auto&& item : cycle) {
+      REQUIRE(item == (i % 3));
+      ++i;
+   }
+   REQUIRE(i == 12);
+   REQUIRE(*(cycle.end() - 1) == 2);
+
+   REQUIRE(std::ranges::empty(tl::views::cycle_n(a, 0)));
+   REQUIRE(std::ranges::empty(tl::views::cycle_n(std::vector<int>{}, 3)));
+}
+
+TEST_CASE("cycle_n forward") {
+   std::list<int> a{ 0, 1, 2 };
+   auto cycle = a | tl::views::cycle_n(3);
+   REQUIRE(cycle.size() == 9);
+   int i = 0;
+   for (auto&& item : cycle) {
+      REQUIRE(item == (i % 3));
+      ++i;
+   }
+   REQUIRE(i == 9);
+
+   auto it = std::ranges::begin(cycle);
+   std::ranges::advance(it, 3);
+   REQUIRE(it != std::ranges::begin(cycle));
+   --it;
+   REQUIRE(*it == 2);
+
+   std::list<int> empty;
+   REQUIRE(std::ranges::empty(empty | tl::views::cycle_n(3)));
+}
+
+TEST_CASE("cycle_n over a view which can't be iterated as const") {
+   std::vector<int> a{ 0, 1, 2, 3, 4 };
+   auto cycle = a | std::views::filter([](int i) { return i % 2 == 0; }) | tl::views::cycle_n(2);
+   std::vector<int> out;
+   for (auto i : cycle) out.push_back(i);
+   REQUIRE(out == std::vector{ 0, 2, 4, 0, 2, 4 });
+
+   auto none = a | std::views::filter([](int i) { return i > 10; }) | tl::views::cycle_n(2);
+   REQUIRE(none.begin() == none.end());
+}
+
+TEST_CASE("cycle segments") {
+   std::vector<int> a{ 0, 1, 2 };
+   auto cycle = a | tl::views::cycle_n(5);
+   int periods = 0;
+   for (auto period : cycle.segments()) {
+      REQUIRE(std::ranges::equal(period, a));
+      ++periods;
+   }
+   REQUIRE(periods == 5);
+
+   std::vector<int> out(7);
+   cycle.copy_to(std::span<int>(out));
+   REQUIRE(out == std::vector<int>{ 0, 1, 2, 0, 1, 2, 0 });
+
+   auto v = cycle | tl::to<std::vector>();
+   REQUIRE(v.size() == 15);
+   REQUIRE(std::ranges::equal(v, cycle));
+}
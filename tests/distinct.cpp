@@ -0,0 +1,40 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include "tl/distinct.hpp"
+#include "tl/to.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("distinct") {
+   std::vector<int> v{ 3, 1, 3, 2, 1, 3 };
+   auto d = v | tl::views::distinct;
+   static_assert(!std::ranges::forward_range<decltype(d)>);
+   REQUIRE(tl::to<std::vector>(d) == std::vector{ 3, 1, 2 });
+   //Iterating again starts afresh
+   REQUIRE(tl::to<std::vector>(d) == std::vector{ 3, 1, 2 });
+
+   std::vector<int> empty;
+   REQUIRE(tl::to<std::vector>(empty | tl::views::distinct(16)).empty());
+}
+
+TEST_CASE("distinct matches std::unordered_set") {
+   std::vector<int> v;
+   for (int i = 0; i < 10000; ++i) v.push_back(i * 7919 % 1237 * 64);
+
+   std::unordered_set<int> seen;
+   std::vector<int> expected;
+   for (auto i : v) {
+      if (seen.insert(i).second) expected.push_back(i);
+   }
+   REQUIRE(tl::to<std::vector>(tl::views::distinct(v, 2000)) == expected);
+}
+
+TEST_CASE("distinct input range") {
+   std::vector<std::string> in{ "b", "a", "b", "c", "a" };
+   std::vector<std::string> words;
+   for (auto const& w : in | tl::views::weaken<tl::weakening::input> | tl::views::distinct) {
+      words.push_back(w);
+   }
+   REQUIRE(words == std::vector<std::string>{ "b", "a", "c" });
+}
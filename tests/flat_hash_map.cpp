@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <map>
+#include "tl/utility/flat_hash_map.hpp"
+
+TEST_CASE("flat_hash_map") {
+   tl::flat_hash_map<std::string, int> m;
+   REQUIRE(m.empty());
+
+   auto [it, inserted] = m.try_emplace("one", 1);
+   REQUIRE(inserted);
+   REQUIRE(it->first == "one");
+   REQUIRE(it->second == 1);
+
+   auto [it2, inserted2] = m.try_emplace("one", 2);
+   REQUIRE(!inserted2);
+   REQUIRE(it2->second == 1);
+
+   m["two"] = 2;
+   m.insert({ "three", 3 });
+   REQUIRE(m.size() == 3);
+   REQUIRE(m.contains("two"));
+   REQUIRE(m.find("three")->second == 3);
+   REQUIRE(m.find("four") == m.end());
+
+   REQUIRE(m.erase("one") == 1);
+   REQUIRE(m.erase("one") == 0);
+   REQUIRE(m.size() == 2);
+   REQUIRE(!m.contains("one"));
+}
+
+TEST_CASE("flat_hash_map matches std::map") {
+   tl::flat_hash_map<int, int> m;
+   std::map<int, int> expected;
+   for (int i = 0; i < 20000; ++i) {
+      //Multiples of 1024 collide in the low bits
+      auto key = (i * 7919) % 5000 * 1024;
+      if (i % 3 == 0) {
+         REQUIRE(m.erase(key) == expected.erase(key));
+      }
+      else {
+         m[key] += i;
+         expected[key] += i;
+      }
+   }
+
+   REQUIRE(m.size() == expected.size());
+   std::map<int, int> contents(m.begin(), m.end());
+   REQUIRE(contents == expected);
+
+   auto const& cm = m;
+   std::size_t n = 0;
+   for (auto const& [k, v] : cm) {
+      REQUIRE(expected.at(k) == v);
+      ++n;
+   }
+   REQUIRE(n == expected.size());
+}
+
+TEST_CASE("flat_hash_set") {
+   tl::flat_hash_set<std::string> s(100);
+   REQUIRE(s.insert("a").second);
+   REQUIRE(s.insert(std::string("b")).second);
+   REQUIRE(!s.insert("a").second);
+   REQUIRE(*s.find("b") == "b");
+   REQUIRE(s.size() == 2);
+
+   REQUIRE(s.erase("a") == 1);
+   REQUIRE(!s.contains("a"));
+   REQUIRE(s.contains("b"));
+}
@@ -2,6 +2,9 @@
 #include <catch2/catch.hpp>
 #include <vector>
 #include <functional>
+#include <string>
+#include "tl/repeat.hpp"
+#include "tl/repeat_n.hpp"
 
 TEST_CASE("fold") {
     std::vector<int> a{ 1, 2, 3, 4 };
@@ -32,4 +35,62 @@ TEST_CASE("fold") {
     REQUIRE(r7 == 0);
     REQUIRE(r8 == 0);
     REQUIRE(r9 == 8);
-}
\ No newline at end of file
+}
+TEST_CASE("parallel fold") {
+    std::vector<long long> a;
+    for (int i = 0; i < 100000; ++i) a.push_back(i % 1000);
+
+    tl::thread_pool pool(3);
+    auto serial = tl::fold_left(a, 5LL, std::plus());
+    REQUIRE(tl::fold_left(tl::par, a, 5LL, std::plus()) == serial);
+    REQUIRE(tl::fold_left(tl::parallel_policy{ .pool = &pool }, a, 5LL, std::plus()) == serial);
+    REQUIRE(tl::sum(tl::parallel_policy{ 4, &pool }, a) == serial - 5);
+
+    //Non-commutative, so blocks must be combined in order
+    std::vector<std::string> words;
+    for (int i = 0; i < 20000; ++i) words.push_back(std::to_string(i % 10));
+    auto concat = [](std::string a, std::string const& b) { return a + b; };
+    REQUIRE(tl::fold_left(tl::parallel_policy{ 8 }, words, std::string("x"), concat) == tl::fold_left(words, std::string("x"), concat));
+}
+
+template <class R, class T, class F>
+concept parallel_foldable = requires(R r, T init, F f) { tl::fold_left(tl::par, r, init, f); };
+
+TEST_CASE("parallel fold with combine") {
+    std::vector<int> a;
+    for (int i = 0; i < 100000; ++i) a.push_back(i % 1000 - 500);
+
+    auto sum_squares = [](long long acc, int x) { return acc + static_cast<long long>(x) * x; };
+    //f can't join two accumulators, so it needs a separate combine
+    STATIC_REQUIRE(!parallel_foldable<std::vector<int>&, long long, decltype(sum_squares)>);
+    REQUIRE(tl::fold_left(tl::parallel_policy{ 8 }, a, 0LL, sum_squares, std::plus()) == tl::fold_left(a, 0LL, sum_squares));
+
+    auto count_negative = [](std::size_t n, int x) { return n + (x < 0); };
+    REQUIRE(tl::fold_left(tl::parallel_policy{ 8 }, a, std::size_t(0), count_negative, std::plus()) == 50000);
+}
+
+TEST_CASE("fold repeated values") {
+    auto five_threes = tl::views::repeat_n(3, 5);
+    REQUIRE(tl::sum(five_threes) == 15);
+    REQUIRE(tl::fold_left(five_threes, 2, std::multiplies()) == 486);
+    REQUIRE(tl::fold_left(tl::views::repeat(7) | std::views::take(4), 1, std::plus()) == 29);
+    REQUIRE(tl::fold_left(tl::views::repeat_n(3, 0), 9, std::multiplies()) == 9);
+    REQUIRE(tl::sum(tl::par, tl::views::repeat_n(2LL, 1000000)) == 2000000);
+    //Would take far too long one element at a time
+    REQUIRE(tl::sum(tl::views::repeat_n(1LL, std::size_t(1) << 40)) == 1LL << 40);
+
+    //Unsigned arithmetic wraps exactly like the step-by-step fold
+    auto big = tl::views::repeat_n(0xFFFFFFF1u, 1001);
+    unsigned expected_sum = 3;
+    unsigned expected_product = 3;
+    for (auto x : big) {
+        expected_sum += x;
+        expected_product *= x;
+    }
+    REQUIRE(tl::fold_left(big, 3u, std::plus()) == expected_sum);
+    REQUIRE(tl::fold_left(big, 3u, std::multiplies()) == expected_product);
+
+    //Not closed form, but still correct
+    auto strings = tl::views::repeat_n(std::string("ab"), 3);
+    REQUIRE(tl::fold_left(strings, std::string(), std::plus()) == "ababab");
+}
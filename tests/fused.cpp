@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <optional>
+#include <ranges>
+#include "tl/fused.hpp"
+#include "tl/enumerate.hpp"
+#include "tl/transform_maybe.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("fused") {
+   std::vector<int> a{ 0,1,2,3,4,5,6,7,8,9 };
+   auto square = [](int i) { return i * i; };
+   auto even = [](int i) { return i % 2 == 0; };
+   auto halve_if_multiple_of_4 = [](int i) { return i % 4 == 0 ? std::optional(i / 4) : std::nullopt; };
+
+   auto fused = a | tl::fuse::transform(square) | tl::fuse::filter(even) | tl::fuse::transform_maybe(halve_if_multiple_of_4);
+   auto unfused = a | std::views::transform(square) | std::views::filter(even) | tl::views::transform_maybe(halve_if_multiple_of_4);
+   STATIC_REQUIRE(std::same_as<decltype(fused), tl::fused_view<std::ranges::ref_view<std::vector<int>>,
+      tl::detail::fused_transform_stage<decltype(square)>, tl::detail::fused_filter_stage<decltype(even)>,
+      tl::detail::fused_transform_maybe_stage<decltype(halve_if_multiple_of_4)>>>);
+   STATIC_REQUIRE(std::ranges::forward_range<decltype(fused)>);
+   REQUIRE(std::ranges::equal(fused, unfused));
+   REQUIRE(sizeof(fused.begin()) < sizeof(unfused.begin()));
+}
+
+TEST_CASE("fused pipelines") {
+   std::vector<int> a{ 5,6,7,8 };
+   auto pipeline = tl::fuse::filter([](int i) { return i != 6; }) | tl::fuse::enumerate
+      | tl::fuse::transform([](auto p) { return static_cast<int>(p.first) * 100 + p.second; });
+   auto r = a | pipeline;
+   REQUIRE(std::ranges::equal(r, std::vector{ 5,107,208 }));
+
+   //Composing with ordinary adaptors
+   auto enumerated = a | (tl::fuse::transform([](int i) { return i + 1; }) | tl::views::enumerate);
+   for (auto [i, e] : enumerated) {
+      REQUIRE(e == static_cast<int>(i) + 6);
+   }
+}
+
+TEST_CASE("fused references") {
+   std::vector<std::pair<int, std::string>> a{ {1, "a"}, {2, "b"}, {3, "c"} };
+   auto r = a | tl::fuse::filter([](auto const& p) { return p.first != 2; })
+      | tl::fuse::transform([](auto& p) -> std::string& { return p.second; });
+   STATIC_REQUIRE(std::same_as<std::ranges::range_reference_t<decltype(r)>, std::string&>);
+   for (auto& s : r) s += "!";
+   REQUIRE(a[0].second == "a!");
+   REQUIRE(a[1].second == "b");
+   REQUIRE(a[2].second == "c!");
+
+   //Enumerating lvalues yields references to them
+   for (auto [i, p] : a | tl::fuse::enumerate) {
+      p.first = static_cast<int>(i);
+   }
+   REQUIRE(a[2].first == 2);
+
+   //Copying iterators doesn't assign through the cached references
+   auto e = a | tl::fuse::enumerate;
+   auto it = e.begin();
+   auto it2 = std::next(it);
+   it = it2;
+   REQUIRE(a[0].first == 0);
+   REQUIRE((*it).first == 1);
+}
+
+TEST_CASE("fused calls each stage once per element") {
+   std::vector<int> a{ 0,1,2,3,4,5 };
+   int transforms = 0;
+   int filters = 0;
+   auto r = a | tl::fuse::transform([&](int i) { ++transforms; return i * 3; })
+      | tl::fuse::filter([&](int i) { ++filters; return i % 2 == 0; });
+   std::vector<int> out;
+   for (auto i : r) out.push_back(i);
+   REQUIRE(out == std::vector{ 0,6,12 });
+   REQUIRE(transforms == 6);
+   REQUIRE(filters == 6);
+}
+
+TEST_CASE("fused input") {
+   std::vector<int> a{ 1,2,3,4,5 };
+   auto r = a | tl::views::weaken<tl::weakening::input> | tl::fuse::filter([](int i) { return i % 2 == 1; }) | tl::fuse::enumerate;
+   STATIC_REQUIRE(!std::ranges::forward_range<decltype(r)>);
+   std::vector<std::pair<std::size_t, int>> out;
+   for (auto p : r) out.push_back(p);
+   REQUIRE(out == std::vector<std::pair<std::size_t, int>>{ {0, 1}, {1, 3}, {2, 5} });
+}
+
+TEST_CASE("fused transform_maybe returning references") {
+   std::vector<std::optional<std::string>> opts{ "a", std::nullopt, "c" };
+   std::vector<int> idx{ 0,1,2 };
+   auto r = idx | tl::fuse::transform_maybe([&](int i) -> std::optional<std::string>& { return opts[i]; });
+   STATIC_REQUIRE(std::same_as<std::ranges::range_reference_t<decltype(r)>, std::string&>);
+   for (auto& s : r) s += "!";
+   REQUIRE(*opts[0] == "a!");
+   REQUIRE(!opts[1]);
+   REQUIRE(*opts[2] == "c!");
+}
@@ -2,6 +2,7 @@
 #include "tl/enumerate.hpp"
 #include "tl/generate.hpp"
 #include <ranges>
+#include <span>
 
 TEST_CASE("generate") {
    for (auto [i, x] : 
@@ -10,4 +11,31 @@ TEST_CASE("generate") {
       | tl::views::enumerate) {
       REQUIRE(i == x);
    }
-}
\ No newline at end of file
+}
+namespace {
+   struct squares {
+      long long next = 0;
+      int* fills = nullptr;
+
+      long long operator()() {
+         auto i = next++;
+         return i * i;
+      }
+      void fill(std::span<long long> out) {
+         ++*fills;
+         for (auto& x : out) x = (*this)();
+      }
+   };
+}
+
+TEST_CASE("generate batched") {
+   int fills = 0;
+   int i = 0;
+   for (auto x : tl::views::generate(squares{ 0, &fills }) | std::views::take(1000)) {
+      REQUIRE(x == static_cast<long long>(i) * i);
+      ++i;
+   }
+   REQUIRE(i == 1000);
+   //Blocks of 512 long longs
+   REQUIRE(fills == 2);
+}
@@ -2,6 +2,9 @@
 #include "tl/enumerate.hpp"
 #include "tl/generate_n.hpp"
 #include <ranges>
+#include <span>
+#include <vector>
+#include "tl/to.hpp"
 
 TEST_CASE("generate n") {
    for (auto [i, x] :
@@ -9,4 +12,55 @@ TEST_CASE("generate n") {
       tl::enumerate_view(tl::views::generate_n([x = 0]() mutable { return x++; }, 10))) {
       REQUIRE(i == x);
    }
-}
\ No newline at end of file
+}
+namespace {
+   //Counts up from 0, in bulk when it can
+   struct counter {
+      int next = 0;
+      int* fills = nullptr;
+
+      int operator()() { return next++; }
+      void fill(std::span<int> out) {
+         ++*fills;
+         for (auto& i : out) i = next++;
+      }
+   };
+}
+
+TEST_CASE("generate n batched") {
+   static_assert(tl::batch_generator<counter>);
+
+   int fills = 0;
+   auto g = tl::views::generate_n(counter{ 0, &fills }, 3000);
+   REQUIRE(g.size() == 3000);
+   std::vector<int> v;
+   for (auto i : g) v.push_back(i);
+   REQUIRE(v.size() == 3000);
+   for (int i = 0; i < 3000; ++i) REQUIRE(v[i] == i);
+   //Blocks of 1024 ints
+   REQUIRE(fills == 3);
+
+   //Skipping elements without reading them still consumes them
+   fills = 0;
+   auto h = tl::views::generate_n(counter{ 0, &fills }, 10);
+   auto it = h.begin();
+   ++it;
+   ++it;
+   REQUIRE(*it == 2);
+   REQUIRE(fills == 1);
+}
+
+TEST_CASE("generate n batched to") {
+   int fills = 0;
+   auto v = tl::to<std::vector>(tl::views::generate_n(counter{ 0, &fills }, 100000));
+   REQUIRE(fills == 1);
+   REQUIRE(v.size() == 100000);
+   REQUIRE(v.back() == 99999);
+
+   //Elements which have been buffered already come first
+   fills = 0;
+   auto g = tl::views::generate_n(counter{ 0, &fills }, 5);
+   auto it = g.begin();
+   REQUIRE(*it == 0);
+   REQUIRE(tl::to<std::vector<int>>(g) == std::vector{ 0, 1, 2, 3, 4 });
+}
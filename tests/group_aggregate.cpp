@@ -0,0 +1,53 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <functional>
+#include <map>
+#include "tl/group_aggregate.hpp"
+
+namespace {
+   struct sale {
+      std::string region;
+      double amount;
+   };
+}
+
+TEST_CASE("group_aggregate") {
+   std::vector<sale> sales{ {"north", 1.0}, {"south", 2.0}, {"north", 3.0}, {"east", 4.0}, {"south", 5.0} };
+   auto totals = tl::group_aggregate(sales, &sale::region, 0.0, [](double acc, sale const& s) { return acc + s.amount; });
+   REQUIRE(totals.size() == 3);
+   REQUIRE(totals.find("north")->second == 4.0);
+   REQUIRE(totals.find("south")->second == 7.0);
+   REQUIRE(totals.find("east")->second == 4.0);
+
+   std::vector<int> empty;
+   REQUIRE(tl::group_aggregate(empty, std::identity{}, 0, std::plus<>{}).empty());
+}
+
+TEST_CASE("group_aggregate preserves order within groups") {
+   std::vector<int> v{ 3, 1, 4, 1, 5, 9, 2, 6 };
+   auto digits = tl::group_aggregate(v, [](int i) { return i % 2; }, std::string{},
+      [](std::string acc, int i) { return acc + std::to_string(i); });
+   REQUIRE(digits.find(0)->second == "426");
+   REQUIRE(digits.find(1)->second == "31159");
+}
+
+TEST_CASE("group_aggregate parallel") {
+   std::vector<int> v;
+   for (int i = 0; i < 200000; ++i) {
+      v.push_back((i * 31) % 1000);
+   }
+   auto key = [](int i) { return i % 97; };
+
+   std::map<int, long long> expected;
+   for (auto i : v) expected[key(i)] += i;
+
+   auto sums = tl::group_aggregate(tl::parallel_policy{ 4 }, v, key, 0LL, std::plus<>{});
+   REQUIRE(sums.size() == expected.size());
+   REQUIRE(std::map<int, long long>(sums.begin(), sums.end()) == expected);
+
+   auto counts = tl::group_aggregate(tl::par, v, key, 0, [](int acc, int) { return acc + 1; }, std::plus<>{});
+   int total = 0;
+   for (auto const& [k, c] : counts) total += c;
+   REQUIRE(total == 200000);
+}
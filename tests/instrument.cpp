@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <ranges>
+#include <sstream>
+#include <optional>
+#include "tl/instrument.hpp"
+#include "tl/transform_maybe.hpp"
+
+TEST_CASE("instrument") {
+   std::vector<int> a{ 0,1,2,3,4 };
+   auto& counters = tl::instrument_registry::global().counters("instrument test");
+   counters.reset();
+
+   auto v = a | tl::views::instrument("instrument test");
+   STATIC_REQUIRE(std::ranges::random_access_range<decltype(v)>);
+   STATIC_REQUIRE(std::ranges::sized_range<decltype(v)>);
+   STATIC_REQUIRE(std::ranges::common_range<decltype(v)>);
+
+   int sum = 0;
+   for (auto i : v) sum += i;
+   REQUIRE(sum == 10);
+   REQUIRE(counters.count(tl::instrument_op::begin) == 1);
+   REQUIRE(counters.count(tl::instrument_op::end) == 1);
+   REQUIRE(counters.count(tl::instrument_op::increment) == 5);
+   REQUIRE(counters.count(tl::instrument_op::dereference) == 5);
+   REQUIRE(counters.count(tl::instrument_op::compare) == 6);
+
+   auto it = v.begin();
+   it += 3;
+   --it;
+   REQUIRE(*it == 2);
+   REQUIRE(v.end() - it == 3);
+   REQUIRE(counters.count(tl::instrument_op::advance) == 1);
+   REQUIRE(counters.count(tl::instrument_op::decrement) == 1);
+   REQUIRE(counters.count(tl::instrument_op::distance) == 1);
+   REQUIRE(counters.time(tl::instrument_op::increment).count() == 0);
+
+   auto copy = it;
+   REQUIRE(*copy == 2);
+   REQUIRE(counters.count(tl::instrument_op::iterator_copy) >= 1);
+}
+
+TEST_CASE("instrument counts function calls") {
+   std::vector<int> a{ 0,1,2,3,4,5,6 };
+   auto& counters = tl::instrument_registry::global().counters("transform_maybe input");
+   counters.reset();
+
+   auto r = a | tl::views::instrument("transform_maybe input", tl::instrument_timing::on)
+      | tl::views::transform_maybe([](int i) { return i % 2 == 0 ? std::optional(i) : std::nullopt; });
+   std::vector<int> out;
+   for (auto i : r) out.push_back(i);
+   REQUIRE(out == std::vector{ 0,2,4,6 });
+   REQUIRE(counters.count(tl::instrument_op::dereference) == 7);
+
+   std::ostringstream os;
+   tl::instrument_registry::global().dump(os);
+   //Only the counts are checked, as the times of such cheap operations can round down to zero and be left out
+   REQUIRE(os.str().find("transform_maybe input: begin=1") != std::string::npos);
+   REQUIRE(os.str().find("dereference=7") != std::string::npos);
+}
+
+TEST_CASE("instrument value-initialized iterators") {
+   std::vector<int> a{ 0,1,2 };
+   auto r = a | tl::views::instrument("value-initialized");
+   decltype(r.begin()) x{}, y{};
+   REQUIRE(x == y);
+
+   decltype(std::views::iota(0, 3) | tl::views::instrument("value-initialized")) empty;
+   REQUIRE(empty.begin() == empty.end());
+}
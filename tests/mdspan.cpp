@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+#include <numeric>
+#include <vector>
+#include "tl/mdspan.hpp"
+
+TEST_CASE("mdspan layouts") {
+   std::vector<int> v(24);
+   std::iota(v.begin(), v.end(), 0);
+
+   auto right = tl::as_mdspan(v, 2, 3, 4);
+   static_assert(decltype(right)::rank() == 3);
+   REQUIRE(right.size() == 24);
+   REQUIRE(right(1, 2, 3) == 23);
+   REQUIRE(right(1, 0, 2) == 14);
+   REQUIRE(right[std::array{ 0, 1, 1 }] == 5);
+   REQUIRE(right.stride(0) == 12);
+   REQUIRE(right.stride(2) == 1);
+   REQUIRE(right.mapping().required_span_size() == 24);
+
+   auto left = tl::as_mdspan<tl::layout_left>(v, 2, 3, 4);
+   REQUIRE(left(1, 0, 0) == 1);
+   REQUIRE(left(0, 1, 0) == 2);
+   REQUIRE(left(1, 2, 3) == 23);
+   REQUIRE(left.stride(2) == 6);
+
+   right(0, 0, 0) = 100;
+   REQUIRE(v[0] == 100);
+}
+
+TEST_CASE("mdspan static extents") {
+   std::vector<float> v(12);
+   tl::mdspan<float, tl::extents<std::size_t, 3, tl::dynamic_extent>> m(v.data(), 4);
+   static_assert(decltype(m)::rank_dynamic() == 1);
+   static_assert(decltype(m)::static_extent(0) == 3);
+   REQUIRE(m.extent(0) == 3);
+   REQUIRE(m.extent(1) == 4);
+   REQUIRE(&m(2, 3) == &v[11]);
+
+   tl::mdspan<float const, tl::extents<std::size_t, 3, tl::dynamic_extent>, tl::layout_stride> strided = m;
+   REQUIRE(strided.stride(0) == 4);
+   REQUIRE(&strided(2, 1) == &v[9]);
+}
+
+TEST_CASE("submdspan") {
+   std::vector<int> v(20);
+   std::iota(v.begin(), v.end(), 0);
+   auto m = tl::as_mdspan(v, 4, 5);
+
+   auto block = tl::submdspan(m, std::pair(1, 3), std::pair(2, 5));
+   static_assert(decltype(block)::rank() == 2);
+   REQUIRE(block.extent(0) == 2);
+   REQUIRE(block.extent(1) == 3);
+   REQUIRE(block(0, 0) == 7);
+   REQUIRE(block(1, 2) == 14);
+   REQUIRE(!block.is_exhaustive());
+
+   auto column = tl::submdspan(m, tl::full_extent, 3);
+   static_assert(decltype(column)::rank() == 1);
+   REQUIRE(column.extent(0) == 4);
+   REQUIRE(column(2) == 13);
+
+   auto point = tl::submdspan(m, 3, 4);
+   static_assert(decltype(point)::rank() == 0);
+   REQUIRE(point() == 19);
+}
+
+TEST_CASE("rows and columns") {
+   std::vector<int> v(12);
+   std::iota(v.begin(), v.end(), 0);
+   auto m = tl::as_mdspan(v, 3, 4);
+
+   auto rows = m | tl::views::rows;
+   static_assert(std::ranges::random_access_range<decltype(rows)>);
+   REQUIRE(std::ranges::size(rows) == 3);
+   REQUIRE(std::ranges::equal(rows[1], std::vector<int>{ 4, 5, 6, 7 }));
+
+   auto columns = m | tl::views::columns;
+   REQUIRE(std::ranges::size(columns) == 4);
+   REQUIRE(std::ranges::equal(columns[2], std::vector<int>{ 2, 6, 10 }));
+
+   //Column-major storage gives the same rows and columns of the logical matrix
+   auto left = tl::as_mdspan<tl::layout_left>(v, 4, 3);
+   REQUIRE(std::ranges::equal((left | tl::views::rows)[1], std::vector<int>{ 1, 5, 9 }));
+   REQUIRE(std::ranges::equal((left | tl::views::columns)[2], std::vector<int>{ 8, 9, 10, 11 }));
+}
+
+TEST_CASE("tiles") {
+   std::vector<int> v(35);
+   std::iota(v.begin(), v.end(), 0);
+   auto m = tl::as_mdspan(v, 5, 7);
+
+   auto tiles = m | tl::views::tiles(2, 3);
+   REQUIRE(std::ranges::size(tiles) == 9);
+
+   auto first = tiles[0];
+   REQUIRE(first.extent(0) == 2);
+   REQUIRE(first.extent(1) == 3);
+   REQUIRE(first(1, 2) == 9);
+
+   //Edge tiles are smaller
+   auto corner = tiles[8];
+   REQUIRE(corner.extent(0) == 1);
+   REQUIRE(corner.extent(1) == 1);
+   REQUIRE(corner(0, 0) == 34);
+
+   //Every element is in exactly one tile
+   std::vector<int> seen(35);
+   for (auto tile : tiles) {
+      for (std::size_t i = 0; i < tile.extent(0); ++i) {
+         for (std::size_t j = 0; j < tile.extent(1); ++j) {
+            ++seen[tile(i, j)];
+         }
+      }
+   }
+   REQUIRE(std::ranges::all_of(seen, [](int n) { return n == 1; }));
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <list>
+#include <string>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include "tl/merge.hpp"
+#include "tl/to.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("merge") {
+   std::vector<int> a{ 1, 4, 7, 10 };
+   std::list<int> b{ 2, 5 };
+   std::vector<int> c{ 3, 6, 8, 9 };
+
+   auto m = tl::views::merge(a, b, c);
+   static_assert(std::ranges::forward_range<decltype(m)>);
+   REQUIRE(m.size() == 10);
+   REQUIRE(tl::to<std::vector>(m) == std::vector{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 });
+
+   auto it = m.begin();
+   auto copy = it;
+   ++it;
+   REQUIRE(*copy == 1);
+   REQUIRE(*it == 2);
+   REQUIRE(copy != it);
+   ++copy;
+   REQUIRE(copy == it);
+}
+
+TEST_CASE("merge with comparator") {
+   std::vector<int> a{ 9, 5, 1 };
+   std::vector<int> b{ 8, 4 };
+   auto m = tl::views::merge(std::ranges::greater{}, a, b);
+   REQUIRE(tl::to<std::vector>(m) == std::vector{ 9, 8, 5, 4, 1 });
+}
+
+TEST_CASE("merge is stable") {
+   std::vector<std::pair<int, char>> a{ {1, 'a'}, {2, 'a'}, {2, 'a'} };
+   std::vector<std::pair<int, char>> b{ {1, 'b'}, {2, 'b'} };
+   std::vector<std::pair<int, char>> c{ {0, 'c'}, {2, 'c'} };
+   auto by_first = [](auto const& x, auto const& y) { return x.first < y.first; };
+
+   std::vector<std::pair<int, char>> expected{ {0, 'c'}, {1, 'a'}, {1, 'b'}, {2, 'a'}, {2, 'a'}, {2, 'b'}, {2, 'c'} };
+   REQUIRE(tl::to<std::vector>(tl::views::merge(by_first, a, b, c)) == expected);
+
+   std::vector<std::vector<std::pair<int, char>>> runs{ a, b, c };
+   REQUIRE(tl::to<std::vector>(runs | tl::views::merge_dynamic(by_first)) == expected);
+}
+
+TEST_CASE("merge empty and mixed ranges") {
+   std::vector<int> empty;
+   std::vector<long> longs{ 2, 3 };
+   std::vector<int> ints{ 1, 4 };
+   auto m = tl::views::merge(empty, longs, empty, ints);
+   static_assert(std::same_as<std::ranges::range_reference_t<decltype(m)>, long>);
+   REQUIRE(tl::to<std::vector>(m) == std::vector<long>{ 1, 2, 3, 4 });
+
+   auto single = tl::views::merge(empty);
+   REQUIRE(single.begin() == single.end());
+}
+
+TEST_CASE("merge input ranges") {
+   std::vector<int> a{ 1, 3, 5 };
+   std::vector<int> b{ 2, 4 };
+   auto m = tl::views::merge(a | tl::views::weaken<tl::weakening::input>, b);
+   static_assert(!std::ranges::forward_range<decltype(m)>);
+   std::vector<int> result;
+   for (auto i : m) result.push_back(i);
+   REQUIRE(result == std::vector{ 1, 2, 3, 4, 5 });
+}
+
+TEST_CASE("merge_dynamic") {
+   std::vector<std::vector<int>> runs;
+   std::vector<int> expected;
+   for (int run = 0; run < 37; ++run) {
+      auto& r = runs.emplace_back();
+      for (int i = 0; i < run % 5; ++i) {
+         r.push_back(run * 7 % 11 + i * 3);
+      }
+      std::ranges::sort(r);
+      expected.insert(expected.end(), r.begin(), r.end());
+   }
+   std::ranges::stable_sort(expected);
+
+   auto m = runs | tl::views::merge_dynamic;
+   REQUIRE(m.size() == expected.size());
+   REQUIRE(tl::to<std::vector>(m) == expected);
+   REQUIRE(tl::to<std::vector>(tl::views::merge_dynamic(runs, std::ranges::less{})) == expected);
+
+   std::vector<std::vector<int>> none;
+   auto empty = none | tl::views::merge_dynamic;
+   REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("merge_dynamic owns prvalue runs") {
+   std::vector<int> sizes{ 3, 1, 2 };
+   auto runs = sizes | std::views::transform([](int n) {
+      std::vector<std::string> run;
+      for (int i = 0; i < n; ++i) run.push_back(std::string(1, static_cast<char>('a' + i * 2 + n % 2)));
+      return run;
+   });
+   std::vector<std::string> result;
+   for (auto& s : runs | tl::views::merge_dynamic) {
+      result.push_back(s);
+   }
+   REQUIRE(result == std::vector<std::string>{ "a", "b", "b", "c", "d", "f" });
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <atomic>
+#include <ranges>
+#include "tl/par_transform.hpp"
+#include "tl/getlines.hpp"
+#include "tl/utility/thread_pool.hpp"
+
+TEST_CASE("thread_pool") {
+   tl::thread_pool pool(4);
+   REQUIRE(pool.size() == 4);
+
+   std::vector<std::future<int>> results;
+   for (int i = 0; i < 100; ++i) {
+      results.push_back(pool.submit([i] { return i * i; }));
+   }
+   for (int i = 0; i < 100; ++i) {
+      REQUIRE(results[i].get() == i * i);
+   }
+
+   auto fails = pool.submit([] { throw std::runtime_error("failed"); });
+   REQUIRE_THROWS_AS(fails.get(), std::runtime_error);
+}
+
+TEST_CASE("par_transform") {
+   std::vector<int> a;
+   for (int i = 0; i < 1000; ++i) a.push_back(i);
+
+   auto r = a | tl::views::par_transform([](int i) { return i * 2; }, 16);
+   STATIC_REQUIRE(std::ranges::input_range<decltype(r)>);
+   STATIC_REQUIRE(std::ranges::sized_range<decltype(r)>);
+   REQUIRE(r.size() == 1000);
+
+   int expected = 0;
+   for (auto i : r) {
+      REQUIRE(i == expected);
+      expected += 2;
+   }
+   REQUIRE(expected == 2000);
+
+   std::vector<int> empty;
+   auto e = empty | tl::views::par_transform([](int i) { return i; });
+   REQUIRE(e.begin() == e.end());
+}
+
+TEST_CASE("par_transform getlines") {
+   std::istringstream is("a\nbb\nccc\ndddd");
+   std::vector<std::size_t> sizes;
+   for (auto s : tl::views::getlines(is) | tl::views::par_transform([](std::string const& s) { return s.size(); }, 2)) {
+      sizes.push_back(s);
+   }
+   REQUIRE(sizes == std::vector<std::size_t>{ 1, 2, 3, 4 });
+}
+
+TEST_CASE("par_transform window") {
+   std::atomic<int> started = 0;
+   std::vector<int> a(100);
+   {
+      auto r = a | tl::views::par_transform([&](int) { return ++started; }, 4);
+      auto it = r.begin();
+      (void)*it;
+      REQUIRE(started <= 4);
+   }
+   REQUIRE(started <= 4);
+}
+
+TEST_CASE("par_transform rethrows") {
+   auto r = std::views::iota(0, 10) | tl::views::par_transform([](int i) {
+      if (i == 5) throw std::runtime_error("5");
+      return i;
+   }, 3);
+
+   int seen = 0;
+   REQUIRE_THROWS_AS([&] { for (auto i : r) { REQUIRE(i == seen); ++seen; } }(), std::runtime_error);
+   REQUIRE(seen == 5);
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <latch>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <ranges>
+#include "tl/prefetch.hpp"
+#include "tl/getlines.hpp"
+#include "tl/utility/spsc_queue.hpp"
+
+TEST_CASE("spsc_queue") {
+   tl::spsc_queue<int> q(3);
+   REQUIRE(q.capacity() == 4);
+
+   std::jthread producer([&] {
+      for (int i = 0; i < 10000; ++i) {
+         q.push(i);
+      }
+      q.finish();
+   });
+
+   int expected = 0;
+   while (auto front = q.front()) {
+      REQUIRE(*front == expected++);
+      q.pop();
+   }
+   REQUIRE(expected == 10000);
+}
+
+TEST_CASE("prefetch") {
+   std::vector<int> a;
+   for (int i = 0; i < 10000; ++i) a.push_back(i);
+
+   auto r = a | tl::views::prefetch(16);
+   STATIC_REQUIRE(std::ranges::input_range<decltype(r)>);
+   STATIC_REQUIRE(!std::ranges::forward_range<decltype(r)>);
+
+   std::vector<int> out;
+   for (auto i : r) out.push_back(i);
+   REQUIRE(out == a);
+
+   std::vector<int> empty;
+   auto e = empty | tl::views::prefetch(16);
+   REQUIRE(e.begin() == e.end());
+}
+
+TEST_CASE("prefetch getlines") {
+   std::istringstream is("one\ntwo\nthree");
+   std::vector<std::string> out;
+   for (auto& line : tl::views::getlines(is) | tl::views::prefetch(2)) {
+      out.push_back(line);
+   }
+   REQUIRE(out == std::vector<std::string>{ "one", "two", "three" });
+}
+
+TEST_CASE("prefetch stops early") {
+   int seen = 0;
+   {
+      auto r = std::views::iota(0) | tl::views::prefetch(8);
+      for (auto i : r) {
+         REQUIRE(i == seen);
+         if (++seen == 100) break;
+      }
+   }
+   REQUIRE(seen == 100);
+}
+
+TEST_CASE("prefetch stops producing when asked") {
+   //The worker blocks while producing element 1, until the stop has been requested
+   std::atomic<int> produced = 0;
+   std::latch reached(1), go(1);
+   auto source = std::views::iota(0) | std::views::transform([&](int i) {
+      ++produced;
+      if (i == 1) {
+         reached.count_down();
+         go.wait();
+      }
+      return i;
+   });
+
+   {
+      auto r = source | tl::views::prefetch(1024);
+      auto it = r.begin();
+      REQUIRE(*it == 0);
+      reached.wait();
+      r.request_stop();
+      go.count_down();
+
+      //The element in flight is still delivered, then the view ends
+      ++it;
+      REQUIRE(*it == 1);
+      ++it;
+      REQUIRE(it == r.end());
+   }
+   REQUIRE(produced == 2);
+}
+
+TEST_CASE("prefetch rethrows") {
+   auto throwing = std::views::iota(0, 100) | std::views::transform([](int i) {
+      if (i == 50) throw std::runtime_error("50");
+      return i;
+   });
+
+   int seen = 0;
+   auto r = throwing | tl::views::prefetch(4);
+   REQUIRE_THROWS_AS([&] { for (auto i : r) { REQUIRE(i == seen); ++seen; } }(), std::runtime_error);
+   REQUIRE(seen == 50);
+}
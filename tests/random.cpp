@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include "tl/random.hpp"
+#include "tl/to.hpp"
+
+TEST_CASE("philox known answers") {
+   //From the Random123 known-answer tests
+   REQUIRE(tl::philox4x32::generate({ 0, 0, 0, 0 }, { 0, 0 }) ==
+      tl::philox4x32::counter_type{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+   REQUIRE(tl::philox4x32::generate({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }) ==
+      tl::philox4x32::counter_type{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+   REQUIRE(tl::philox4x32::generate({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }) ==
+      tl::philox4x32::counter_type{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+
+   static_assert(std::uniform_random_bit_generator<tl::philox_engine>);
+   tl::philox_engine engine(0);
+   REQUIRE(engine() == 0x6627e8d5);
+}
+
+TEST_CASE("random view") {
+   auto r = tl::views::random<std::uniform_real_distribution<float>>(42, 10000);
+   static_assert(std::ranges::random_access_range<decltype(r)>);
+   static_assert(std::ranges::sized_range<decltype(r)>);
+   REQUIRE(r.size() == 10000);
+
+   auto v = tl::to<std::vector>(r);
+   REQUIRE(v.size() == 10000);
+   REQUIRE(std::ranges::all_of(v, [](float f) { return f >= 0 && f < 1; }));
+   auto mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+   REQUIRE(std::abs(mean - 0.5) < 0.02);
+
+   //Elements only depend on the seed and their index
+   REQUIRE(r[1234] == v[1234]);
+   REQUIRE(*(r.begin() + 9999) == v.back());
+   REQUIRE(tl::views::random<std::uniform_real_distribution<float>>(42)[5000] == v[5000]);
+   REQUIRE(tl::views::random<std::uniform_real_distribution<float>>(43)[5000] != v[5000]);
+   REQUIRE(tl::to<std::vector<float>>(tl::par, r) == v);
+}
+
+TEST_CASE("random view distributions") {
+   auto normal = tl::to<std::vector>(tl::views::random<std::normal_distribution<double>>(7, 20000, std::normal_distribution<double>(10, 2)));
+   auto mean = std::accumulate(normal.begin(), normal.end(), 0.0) / normal.size();
+   auto variance = std::accumulate(normal.begin(), normal.end(), 0.0,
+      [&](double acc, double x) { return acc + (x - mean) * (x - mean); }) / normal.size();
+   REQUIRE(std::abs(mean - 10) < 0.1);
+   REQUIRE(std::abs(std::sqrt(variance) - 2) < 0.1);
+
+   auto dice = tl::views::random<std::uniform_int_distribution<int>>(1, 6000, std::uniform_int_distribution<int>(1, 6));
+   std::vector<int> counts(7);
+   for (auto d : dice) ++counts[d];
+   REQUIRE(counts[0] == 0);
+   for (int face = 1; face <= 6; ++face) {
+      REQUIRE(counts[face] > 850);
+      REQUIRE(counts[face] < 1150);
+   }
+   REQUIRE(tl::to<std::vector<int>>(tl::parallel_policy{ 4 }, dice) == tl::to<std::vector<int>>(dice));
+}
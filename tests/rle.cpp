@@ -0,0 +1,43 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <list>
+#include <utility>
+#include "tl/rle.hpp"
+
+TEST_CASE("rle") {
+   std::vector<int> v{ 1, 1, 2, 3, 3, 3 };
+   std::vector<std::pair<int, std::ptrdiff_t>> expected{ {1, 2}, {2, 1}, {3, 3} };
+
+   std::vector<std::pair<int, std::ptrdiff_t>> result;
+   for (auto&& [value, count] : v | tl::views::rle) {
+      result.emplace_back(value, count);
+   }
+   REQUIRE(result == expected);
+}
+
+TEST_CASE("rle long runs") {
+   std::vector<int> v(40, 7);
+   v.insert(v.end(), 3, 8);
+
+   auto r = tl::rle_view(v);
+   auto it = r.begin();
+   REQUIRE(*it == std::pair<int, std::ptrdiff_t>{ 7, 40 });
+   ++it;
+   REQUIRE(*it == std::pair<int, std::ptrdiff_t>{ 8, 3 });
+   ++it;
+   REQUIRE(it == r.end());
+}
+
+TEST_CASE("rle non-contiguous") {
+   std::list<char> l{ 'a', 'a', 'b' };
+   std::vector<std::pair<char, std::ptrdiff_t>> result;
+   for (auto&& p : l | tl::views::rle) {
+      result.push_back(p);
+   }
+   REQUIRE(result == std::vector<std::pair<char, std::ptrdiff_t>>{ {'a', 2}, {'b', 1} });
+}
+
+TEST_CASE("rle empty") {
+   std::vector<int> v;
+   REQUIRE(std::ranges::empty(v | tl::views::rle));
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include "tl/sample.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("sample") {
+   std::mt19937 rng(42);
+   std::vector<int> v{ 1, 2, 3 };
+
+   auto all = tl::sample(v, 5, rng);
+   std::ranges::sort(all);
+   REQUIRE(all == v);
+   REQUIRE(tl::sample(v, 0, rng).empty());
+
+   std::list<int> l;
+   for (int i = 0; i < 1000; ++i) l.push_back(i);
+   auto s = tl::sample(l | tl::views::weaken<tl::weakening::input>, 10, rng);
+   REQUIRE(s.size() == 10);
+   std::ranges::sort(s);
+   REQUIRE(std::ranges::adjacent_find(s) == s.end());
+   REQUIRE(std::ranges::all_of(s, [](int i) { return i >= 0 && i < 1000; }));
+}
+
+TEST_CASE("sample is uniform") {
+   std::mt19937 rng(1234);
+   std::vector<int> v(100);
+   std::iota(v.begin(), v.end(), 0);
+
+   //Each element should be picked about trials * k / n = 1000 times
+   std::vector<int> counts(v.size());
+   constexpr int trials = 10000;
+   for (int trial = 0; trial < trials; ++trial) {
+      for (auto i : tl::sample(v, 10, rng)) ++counts[i];
+   }
+   REQUIRE(std::ranges::min(counts) > 850);
+   REQUIRE(std::ranges::max(counts) < 1150);
+}
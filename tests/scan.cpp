@@ -0,0 +1,40 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <functional>
+#include <iterator>
+#include "tl/scan.hpp"
+
+TEST_CASE("inclusive_scan") {
+   std::vector<int> a{ 1,2,3,4 };
+   std::vector<int> out;
+   tl::inclusive_scan(a, std::back_inserter(out));
+   REQUIRE(out == std::vector{ 1,3,6,10 });
+
+   std::vector<int> products(4);
+   auto end = tl::inclusive_scan(a, products.begin(), std::multiplies());
+   REQUIRE(end == products.end());
+   REQUIRE(products == std::vector{ 1,2,6,24 });
+}
+
+TEST_CASE("parallel inclusive_scan") {
+   std::vector<long long> a;
+   for (int i = 0; i < 100003; ++i) a.push_back(i % 7 - 3);
+
+   std::vector<long long> serial(a.size());
+   tl::inclusive_scan(a, serial.begin());
+
+   std::vector<long long> parallel(a.size());
+   auto end = tl::inclusive_scan(tl::parallel_policy{ 5 }, a, parallel.begin());
+   REQUIRE(end == parallel.end());
+   REQUIRE(parallel == serial);
+
+   //Non-commutative
+   std::vector<std::string> words;
+   for (int i = 0; i < 9000; ++i) words.push_back(std::to_string(i % 3));
+   auto concat = [](std::string a, std::string const& b) { return (a + b).substr(a.size() + b.size() > 6 ? a.size() + b.size() - 6 : 0); };
+   std::vector<std::string> serial_words(words.size()), parallel_words(words.size());
+   tl::inclusive_scan(words, serial_words.begin(), concat);
+   tl::inclusive_scan(tl::parallel_policy{ 3 }, words, parallel_words.begin(), concat);
+   REQUIRE(parallel_words == serial_words);
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include "tl/set_operations.hpp"
+#include "tl/to.hpp"
+#include "tl/weaken.hpp"
+
+namespace {
+   //Checks each view against the std:: algorithm of the same name
+   template <class A, class B>
+   void check_all(A const& a, B const& b) {
+      std::vector<int> expected;
+
+      std::ranges::set_union(a, b, std::back_inserter(expected));
+      REQUIRE(tl::to<std::vector<int>>(tl::views::set_union(a, b)) == expected);
+
+      expected.clear();
+      std::ranges::set_intersection(a, b, std::back_inserter(expected));
+      REQUIRE(tl::to<std::vector<int>>(tl::views::set_intersection(a, b)) == expected);
+
+      expected.clear();
+      std::ranges::set_difference(a, b, std::back_inserter(expected));
+      REQUIRE(tl::to<std::vector<int>>(tl::views::set_difference(a, b)) == expected);
+
+      expected.clear();
+      std::ranges::set_symmetric_difference(a, b, std::back_inserter(expected));
+      REQUIRE(tl::to<std::vector<int>>(tl::views::set_symmetric_difference(a, b)) == expected);
+   }
+}
+
+TEST_CASE("set operations") {
+   std::vector<int> a{ 1, 2, 2, 3, 5, 8, 8, 8, 13 };
+   std::vector<int> b{ 0, 2, 3, 3, 8, 8, 21 };
+   std::vector<int> empty;
+
+   check_all(a, b);
+   check_all(b, a);
+   check_all(a, empty);
+   check_all(empty, a);
+   check_all(std::list<int>(a.begin(), a.end()), std::list<int>(b.begin(), b.end()));
+
+   REQUIRE(tl::to<std::vector>(a | tl::views::set_intersection(b)) == std::vector{ 2, 3, 8, 8 });
+}
+
+TEST_CASE("set operations galloping") {
+   std::vector<int> posting;
+   for (int i = 0; i < 10000; ++i) posting.push_back(i * 3);
+   std::vector<int> query{ -1, 3, 299, 300, 9000, 29997, 40000 };
+
+   check_all(posting, query);
+   check_all(query, posting);
+
+   //Skipping over the long list should take far fewer comparisons than walking it
+   int comparisons = 0;
+   auto counting_less = [&](int x, int y) { ++comparisons; return x < y; };
+   auto result = tl::to<std::vector>(tl::views::set_intersection(query, posting, counting_less));
+   REQUIRE(result == std::vector{ 3, 300, 9000, 29997 });
+   REQUIRE(comparisons < 300);
+}
+
+TEST_CASE("set operations with comparator") {
+   std::vector<int> a{ 9, 7, 5, 3 };
+   std::vector<int> b{ 8, 7, 3, 1 };
+   REQUIRE(tl::to<std::vector>(a | tl::views::set_union(b, std::ranges::greater{})) == std::vector{ 9, 8, 7, 5, 3, 1 });
+   REQUIRE(tl::to<std::vector>(tl::views::set_difference(a, b, std::ranges::greater{})) == std::vector{ 9, 5 });
+}
+
+TEST_CASE("set operations on input ranges") {
+   std::vector<int> a{ 1, 2, 4, 6 };
+   std::vector<int> b{ 2, 3, 6 };
+   auto u = a | tl::views::weaken<tl::weakening::input> | tl::views::set_union(b);
+   static_assert(!std::ranges::forward_range<decltype(u)>);
+   std::vector<int> result;
+   for (auto i : u) result.push_back(i);
+   REQUIRE(result == std::vector{ 1, 2, 3, 4, 6 });
+}
+
+TEST_CASE("set operations iterators") {
+   std::vector<int> a{ 1, 3, 5, 7 };
+   std::vector<int> b{ 3, 7 };
+   auto d = tl::views::set_difference(a, b);
+   static_assert(std::ranges::forward_range<decltype(d)>);
+   auto it = d.begin();
+   auto copy = it;
+   REQUIRE(*it == 1);
+   ++it;
+   REQUIRE(*it == 5);
+   REQUIRE(copy != it);
+   REQUIRE(++copy == it);
+   REQUIRE(++it == d.end());
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "tl/sink.hpp"
+#include "tl/to.hpp"
+
+namespace {
+   //Records the size of every block it's given
+   struct counting_sink {
+      std::vector<int> values;
+      std::vector<std::size_t> blocks;
+
+      void put(std::span<int const> block) {
+         blocks.push_back(block.size());
+         values.insert(values.end(), block.begin(), block.end());
+      }
+   };
+}
+
+TEST_CASE("copy to sink in blocks") {
+   std::vector<int> v(5000);
+   std::iota(v.begin(), v.end(), 0);
+
+   counting_sink contiguous;
+   tl::copy(v, contiguous);
+   REQUIRE(contiguous.values == v);
+   REQUIRE(contiguous.blocks == std::vector<std::size_t>{ 5000 });
+
+   counting_sink staged;
+   v | std::views::transform([](int i) { return i; }) | tl::copy(staged);
+   REQUIRE(staged.values == v);
+   REQUIRE(staged.blocks.size() < 30);
+
+   std::list<int> l{ 1, 2, 3 };
+   counting_sink from_list;
+   tl::to(l, from_list);
+   REQUIRE(from_list.values == std::vector<int>{ 1, 2, 3 });
+   REQUIRE(from_list.blocks == std::vector<std::size_t>{ 3 });
+}
+
+TEST_CASE("append sink") {
+   std::vector<int> out{ 0 };
+   auto sink = tl::sink::append(out);
+   std::views::iota(1, 6) | tl::to(sink);
+   std::vector<int>{ 6, 7 } | tl::copy(sink);
+   REQUIRE(out == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+   REQUIRE((std::views::iota(0, 8) | tl::to<std::vector>()) == out);
+
+   std::string s;
+   auto chars = tl::sink::append(s);
+   tl::copy(std::string_view("hello"), chars);
+   REQUIRE(s == "hello");
+}
+
+TEST_CASE("ostream sink") {
+   std::ostringstream os;
+   {
+      auto sink = tl::sink::ostream(os);
+      std::vector<int>{ 1, -20, 300 } | tl::copy(sink);
+      std::vector<double>{ 0.5 } | tl::copy(sink);
+      std::vector<std::string>{ "a", "bc" } | tl::copy(sink);
+      tl::copy(std::string_view("raw"), sink);
+      //Nothing is written until the buffer fills or the sink is flushed
+      REQUIRE(os.str().empty());
+   }
+   REQUIRE(os.str() == "1\n-20\n300\n0.5\na\nbc\nraw");
+
+   std::ostringstream csv;
+   auto sink = tl::sink::ostream(csv, ",");
+   std::views::iota(0, 10000) | tl::copy(sink);
+   sink.flush();
+   auto text = csv.str();
+   REQUIRE(text.substr(0, 8) == "0,1,2,3,");
+   REQUIRE(text.substr(text.size() - 5) == "9999,");
+}
+
+TEST_CASE("ostream sink errors") {
+   //A stream buffer which can't be written to
+   struct failing_buf : std::streambuf {
+      int overflow(int) override { return traits_type::eof(); }
+   };
+   failing_buf buf;
+   std::ostream os(&buf);
+   os.exceptions(std::ios_base::badbit);
+
+   auto sink = tl::sink::ostream(os);
+   std::string_view("abc") | tl::copy(sink);
+   REQUIRE_THROWS_AS(sink.flush(), std::ios_base::failure);
+
+   //The destructor swallows the error
+   REQUIRE_NOTHROW([&] {
+      auto dropped = tl::sink::ostream(os);
+      std::string_view("abc") | tl::copy(dropped);
+   }());
+}
+
+#ifndef _WIN32
+TEST_CASE("file sink") {
+   auto f = std::tmpfile();
+   REQUIRE(f);
+   std::vector<int> big(100000);
+   std::iota(big.begin(), big.end(), 0);
+   {
+      auto sink = tl::sink::file(fileno(f));
+      std::vector<int>{ -1, -2 } | tl::copy(sink);
+      big | std::views::transform([](int i) { return i; }) | tl::copy(sink);
+      tl::copy(big, sink);
+   }
+   std::rewind(f);
+   std::vector<int> read(2 + 2 * big.size());
+   REQUIRE(std::fread(read.data(), sizeof(int), read.size(), f) == read.size());
+   std::fclose(f);
+   REQUIRE(read[0] == -1);
+   REQUIRE(read[1] == -2);
+   REQUIRE(std::equal(big.begin(), big.end(), read.begin() + 2));
+   REQUIRE(std::equal(big.begin(), big.end(), read.begin() + 2 + big.size()));
+}
+
+TEST_CASE("file sink errors") {
+   REQUIRE_THROWS_AS(tl::sink::file(-2), std::system_error);
+
+   //Writing to a file opened for reading fails whether or not the block is buffered
+   auto f = std::fopen("/dev/null", "r");
+   REQUIRE(f);
+   {
+      auto sink = tl::sink::file(fileno(f));
+      std::vector<char>{ 'a', 'b' } | tl::copy(sink);
+      REQUIRE_THROWS_AS(sink.flush(), std::system_error);
+      std::vector<char> bytes(1 << 17);
+      REQUIRE_THROWS_AS(tl::copy(bytes, sink), std::system_error);
+   }
+   std::fclose(f);
+}
+#endif
+
+TEST_CASE("partition sink") {
+   auto sink = tl::sink::partition<int>(3, [](int x) { return x; });
+   std::views::iota(0, 10) | tl::copy(sink);
+   auto& buckets = sink.buckets();
+   REQUIRE(buckets.size() == 3);
+   REQUIRE(buckets[0] == std::vector<int>{ 0, 3, 6, 9 });
+   REQUIRE(buckets[1] == std::vector<int>{ 1, 4, 7 });
+   REQUIRE(buckets[2] == std::vector<int>{ 2, 5, 8 });
+}
@@ -2,6 +2,8 @@
 #include <vector>
 #include <tl/stride.hpp>
 #include <tl/cartesian_product.hpp>
+#include <tl/fold.hpp>
+#include <tl/to.hpp>
 #include <ranges>
 #include <iostream>
 #include <list>
@@ -85,4 +87,21 @@ TEST_CASE("offset") {
       --it;
       REQUIRE(*it == 3);
    }
-}
\ No newline at end of file
+}
+TEST_CASE("strided span") {
+   std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6 };
+   auto s = v | tl::views::stride(3);
+   auto span = s.as_strided_span();
+   REQUIRE(span.data() == v.data());
+   REQUIRE(span.size() == 3);
+   REQUIRE(span.stride() == 3);
+   REQUIRE(std::ranges::equal(span, s));
+
+   REQUIRE((s | tl::to<std::vector>()) == std::vector<int>{ 0, 3, 6 });
+   REQUIRE(tl::fold_left(s, 0, std::plus()) == 9);
+   REQUIRE(tl::sum(v | tl::views::stride(2)) == 12);
+
+   std::vector<int> out(2);
+   s.copy_to(std::span<int>(out));
+   REQUIRE(out == std::vector<int>{ 0, 3 });
+}
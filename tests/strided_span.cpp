@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include "tl/strided_span.hpp"
+#include "tl/to.hpp"
+
+TEST_CASE("strided_span column") {
+   //5x3 row-major matrix
+   std::vector<int> m(15);
+   std::iota(m.begin(), m.end(), 0);
+   tl::strided_span col(m.data() + 1, 5, 3);
+   static_assert(std::ranges::random_access_range<decltype(col)>);
+   static_assert(std::ranges::sized_range<decltype(col)>);
+   REQUIRE(col.size() == 5);
+   REQUIRE(std::ranges::equal(col, std::vector<int>{ 1, 4, 7, 10, 13 }));
+   REQUIRE(col[2] == 7);
+   REQUIRE(col.end() - col.begin() == 5);
+   REQUIRE(*(col.end() - 1) == 13);
+
+   col[0] = 100;
+   REQUIRE(m[1] == 100);
+}
+
+TEST_CASE("strided_span negative stride") {
+   std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6 };
+   tl::strided_span s(v.data() + 6, 4, -2);
+   REQUIRE(std::ranges::equal(s, std::vector<int>{ 6, 4, 2, 0 }));
+
+   std::vector<int> out(4);
+   tl::strided_copy(s, out.data());
+   REQUIRE(out == std::vector<int>{ 6, 4, 2, 0 });
+}
+
+template <class T>
+void check_strided_copy(std::size_t n, std::ptrdiff_t stride) {
+   std::vector<T> in(n * stride);
+   for (std::size_t i = 0; i < in.size(); ++i) in[i] = static_cast<T>(i % 1000);
+   std::vector<T> out(n);
+   tl::strided_copy(tl::strided_span<T const>(in.data(), n, stride), out.data());
+   for (std::size_t i = 0; i < n; ++i) {
+      REQUIRE(out[i] == in[i * stride]);
+   }
+}
+
+TEST_CASE("strided_copy") {
+   for (std::size_t n : { 0, 1, 3, 7, 8, 9, 31, 100 }) {
+      for (std::ptrdiff_t stride : { 1, 2, 5, 64 }) {
+         check_strided_copy<int>(n, stride);
+         check_strided_copy<float>(n, stride);
+         check_strided_copy<double>(n, stride);
+         check_strided_copy<std::int64_t>(n, stride);
+         check_strided_copy<std::uint32_t>(n, stride);
+         check_strided_copy<short>(n, stride);
+      }
+   }
+}
+
+TEST_CASE("strided_span to") {
+   std::vector<double> m(40);
+   std::iota(m.begin(), m.end(), 0.0);
+   auto col = tl::strided_span<double const>(m.data() + 3, 10, 4) | tl::to<std::vector>();
+   REQUIRE(col.size() == 10);
+   for (std::size_t i = 0; i < col.size(); ++i) {
+      REQUIRE(col[i] == m[3 + 4 * i]);
+   }
+}
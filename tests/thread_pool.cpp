@@ -0,0 +1,48 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include "tl/utility/thread_pool.hpp"
+
+TEST_CASE("thread_pool parallel_for") {
+   tl::thread_pool pool(4);
+   std::vector<int> hits(10007);
+   pool.parallel_for(0, hits.size(), 100, [&](std::size_t first, std::size_t last) {
+      REQUIRE(last - first <= 100);
+      for (auto i = first; i != last; ++i) ++hits[i];
+   });
+   REQUIRE(std::ranges::all_of(hits, [](int h) { return h == 1; }));
+
+   pool.parallel_for(5, 5, 1, [](std::size_t, std::size_t) { FAIL("called on empty range"); });
+}
+
+TEST_CASE("thread_pool nested parallel_for") {
+   //More nested loops than threads, which would deadlock if waiting threads didn't run other tasks
+   tl::thread_pool pool(2);
+   std::atomic<int> total = 0;
+   pool.parallel_for(0, 16, 1, [&](std::size_t, std::size_t) {
+      pool.parallel_for(0, 100, 10, [&](std::size_t first, std::size_t last) {
+         total += static_cast<int>(last - first);
+      });
+   });
+   REQUIRE(total == 1600);
+
+   auto f = pool.submit([&] {
+      int inner = 0;
+      pool.parallel_for(0, 10, 1, [&](std::size_t, std::size_t) {});
+      auto g = pool.submit([] { return 1; });
+      pool.wait(g);
+      return inner + g.get();
+   });
+   REQUIRE(f.get() == 1);
+}
+
+TEST_CASE("thread_pool exceptions") {
+   tl::thread_pool pool(3);
+   REQUIRE_THROWS_AS(pool.parallel_for(0, 1000, 10, [](std::size_t first, std::size_t) {
+      if (first >= 500) throw std::runtime_error("failed");
+   }), std::runtime_error);
+
+   auto f = pool.submit([] { throw std::runtime_error("failed"); });
+   REQUIRE_THROWS_AS(f.get(), std::runtime_error);
+}
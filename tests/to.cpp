@@ -4,7 +4,10 @@
 #include <list>
 #include <forward_list>
 #include <deque>
+#include <string>
 #include "tl/cycle.hpp"
+#include "tl/repeat.hpp"
+#include "tl/repeat_n.hpp"
 
 TEST_CASE("copy ctor") {
    std::vector<int> a{ 0,1,2 };
@@ -77,4 +80,28 @@ TEST_CASE("associative") {
    REQUIRE(std::ranges::equal(vec, a));
    auto map = vec | tl::to<std::map>();
    REQUIRE(std::ranges::equal(map, a));
-}
\ No newline at end of file
+}
+TEST_CASE("parallel to") {
+   std::vector<int> a;
+   for (int i = 0; i < 50000; ++i) a.push_back(i);
+   auto squares = a | std::views::transform([](int i) { return static_cast<long long>(i) * i; });
+
+   auto v = tl::to<std::vector<long long>>(tl::par, squares);
+   REQUIRE(v.size() == a.size());
+   REQUIRE(std::ranges::equal(v, squares));
+
+   auto d = tl::to<std::deque>(tl::parallel_policy{ 3 }, squares);
+   REQUIRE(std::ranges::equal(d, squares));
+
+   auto l = tl::to<std::list<int>>(tl::par, a);
+   REQUIRE(std::ranges::equal(l, a));
+}
+
+TEST_CASE("to repeated values") {
+   REQUIRE(tl::to<std::vector<int>>(tl::views::repeat_n(7, 3)) == std::vector{ 7, 7, 7 });
+   REQUIRE(tl::to<std::vector>(tl::views::repeat(std::string("x")) | std::views::take(2)) == std::vector<std::string>{ "x", "x" });
+   REQUIRE(tl::to<std::string>(tl::views::repeat_n('-', 4)) == "----");
+   REQUIRE(tl::to<std::vector<char>>(tl::par, tl::views::repeat_n('\0', 100000)) == std::vector<char>(100000, '\0'));
+   REQUIRE(tl::to<std::list<int>>(tl::views::repeat_n(1, 2)) == std::list{ 1, 1 });
+   REQUIRE(tl::to<std::vector<int>>(tl::views::repeat_n(1, 0)).empty());
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include "tl/top_k.hpp"
+#include "tl/weaken.hpp"
+
+TEST_CASE("top_k") {
+   std::vector<int> v{ 5, 1, 9, 3, 7, 2, 8 };
+   REQUIRE(tl::top_k(v, 3) == std::vector{ 1, 2, 3 });
+   REQUIRE(tl::top_k(v, 3, std::ranges::greater{}) == std::vector{ 9, 8, 7 });
+   REQUIRE(tl::top_k(v, 0).empty());
+   REQUIRE(tl::top_k(v, 100) == std::vector{ 1, 2, 3, 5, 7, 8, 9 });
+}
+
+TEST_CASE("top_k with projection over an input range") {
+   struct item {
+      std::string name;
+      int score;
+   };
+   std::vector<item> items{ {"a", 3}, {"b", 10}, {"c", 1}, {"d", 7} };
+   auto best = tl::top_k(items | tl::views::weaken<tl::weakening::input>, 2, std::ranges::greater{}, &item::score);
+   REQUIRE(best.size() == 2);
+   REQUIRE(best[0].name == "b");
+   REQUIRE(best[1].name == "d");
+}
+
+TEST_CASE("top_k with k larger than the range") {
+   //Only as much as the range needs is reserved
+   std::vector<int> v{ 5, 1, 4, 2, 3 };
+   auto huge = std::size_t(1) << 40;
+   REQUIRE(tl::top_k(v, huge) == std::vector{ 1, 2, 3, 4, 5 });
+   REQUIRE(tl::top_k(v | tl::views::weaken<tl::weakening::input>, huge) == std::vector{ 1, 2, 3, 4, 5 });
+}
+
+TEST_CASE("parallel top_k") {
+   std::vector<long> v;
+   for (long i = 0; i < 200000; ++i) v.push_back(i * 7919 % 200003);
+
+   auto expected = v;
+   std::ranges::sort(expected, std::ranges::greater{});
+   expected.resize(100);
+
+   tl::thread_pool pool(4);
+   REQUIRE(tl::top_k(tl::parallel_policy{ .pool = &pool }, v, 100, std::ranges::greater{}) == expected);
+   REQUIRE(tl::top_k(tl::par, v, 100, std::ranges::greater{}) == expected);
+   REQUIRE(tl::top_k(tl::par, v, 0).empty());
+}
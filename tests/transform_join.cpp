@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 #include <ranges>
 #include <iostream>
+#include <string>
+#include <vector>
 #include "tl/transform_join.hpp"
 
 TEST_CASE("transform join view") {
@@ -15,4 +17,56 @@ TEST_CASE("transform join container") {
   for (auto&& e : a | tl::views::transform_join([](auto i) { return std::vector<int>{i,i}; })) {
     std::cout << e;
   }
-}
\ No newline at end of file
+}
+TEST_CASE("transform join container contents") {
+  std::vector<int> a{ 0, 1, 2, 0, 3 };
+  auto r = a | tl::views::transform_join([](int i) { return std::vector<int>(i, i); });
+  std::vector<int> out;
+  for (auto&& e : r) out.push_back(e);
+  REQUIRE(out == std::vector<int>{ 1, 2, 2, 3, 3, 3 });
+
+  std::vector<std::size_t> sizes;
+  r.for_each_segment([&](auto& inner) { sizes.push_back(inner.size()); });
+  REQUIRE(sizes == std::vector<std::size_t>{ 1, 2, 3 });
+}
+
+TEST_CASE("transform join into") {
+  std::vector<int> a{ 3, 0, 1, 2 };
+  int calls = 0;
+  auto r = a | tl::views::transform_join_into<int>([&calls](int i, std::vector<int>& out) {
+    ++calls;
+    for (int j = 0; j < i; ++j) out.push_back(i * 10 + j);
+  }, 8);
+  static_assert(std::ranges::input_range<decltype(r)>);
+
+  std::vector<int> out;
+  for (auto&& e : r) out.push_back(e);
+  REQUIRE(out == std::vector<int>{ 30, 31, 32, 10, 20, 21 });
+  REQUIRE(calls == 4);
+
+  int total = 0;
+  r.for_each_segment([&](std::vector<int> const& inner) {
+    REQUIRE(inner.capacity() >= 8);
+    for (auto x : inner) total += x;
+  });
+  REQUIRE(total == 30 + 31 + 32 + 10 + 20 + 21);
+
+  std::vector<int> empty;
+  auto none = empty | tl::views::transform_join_into<int>([](int, std::vector<int>&) {});
+  REQUIRE(none.begin() == none.end());
+}
+
+TEST_CASE("transform join into strings") {
+  std::vector<std::string> lines{ "a b", "", "c d e" };
+  auto words = lines | tl::views::transform_join_into<std::string>([](std::string const& line, auto& out) {
+    std::string word;
+    for (char c : line) {
+      if (c == ' ') { out.push_back(word); word.clear(); }
+      else word += c;
+    }
+    if (!word.empty()) out.push_back(word);
+  });
+  std::vector<std::string> result;
+  for (auto&& w : words) result.push_back(w);
+  REQUIRE(result == std::vector<std::string>{ "a", "b", "c", "d", "e" });
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include "tl/enumerate.hpp"
 #include "tl/transform_maybe.hpp"
+#include "tl/weaken.hpp"
 
 TEST_CASE("transform_maybe") {
    std::vector<int> a{ 0,1,2,3,4 };
@@ -24,4 +25,38 @@ TEST_CASE("bidirectional") {
    REQUIRE(*--it == 2);
    REQUIRE(*--it == 1);
    REQUIRE(*++it == 2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("transform_maybe back to begin") {
+   std::vector<int> a{ 1,2,3,4 };
+   auto f = [](auto i) { return (i % 2 == 0) ? std::optional(i) : std::nullopt; };
+
+   auto r = a | tl::views::transform_maybe(f);
+   auto it = r.end();
+   REQUIRE(*--it == 4);
+   REQUIRE(*--it == 2);
+   REQUIRE(it == r.begin());
+}
+
+TEST_CASE("transform_maybe calls function once per element") {
+   std::vector<int> a{ 0,1,2,3,4,5,6 };
+   int calls = 0;
+   auto f = [&](auto i) { ++calls; return (i % 3 == 0) ? std::optional(i) : std::nullopt; };
+
+   auto r = a | tl::views::transform_maybe(f);
+   std::vector<int> out;
+   for (auto i : r) out.push_back(i);
+   REQUIRE(out == std::vector{ 0,3,6 });
+   REQUIRE(calls == 7);
+
+   auto in = a | tl::views::weaken<tl::weakening::input> | tl::views::transform_maybe(f);
+   STATIC_REQUIRE(!std::ranges::forward_range<decltype(in)>);
+   calls = 0;
+   out.clear();
+   for (auto i : in) out.push_back(i);
+   REQUIRE(out == std::vector{ 0,3,6 });
+   REQUIRE(calls == 7);
+
+   std::vector<int> empty;
+   REQUIRE(std::ranges::empty(empty | tl::views::transform_maybe(f)));
+}
@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include "tl/unique.hpp"
+#include "tl/to.hpp"
+
+TEST_CASE("unique") {
+   std::vector<int> v{ 1, 1, 2, 3, 3, 3, 1 };
+   REQUIRE(tl::to<std::vector>(v | tl::views::unique) == std::vector{ 1, 2, 3, 1 });
+
+   std::list<std::string> l{ "a", "a", "b" };
+   REQUIRE(tl::to<std::vector>(tl::views::unique(l)) == std::vector<std::string>{ "a", "b" });
+
+   std::vector<int> empty;
+   REQUIRE((empty | tl::views::unique).empty());
+}
+
+TEST_CASE("unique with predicate") {
+   std::vector<int> v{ 1, 3, 2, 4, 7, 9, 10 };
+   auto same_parity = [](int a, int b) { return a % 2 == b % 2; };
+   REQUIRE(tl::to<std::vector>(v | tl::views::unique(same_parity)) == std::vector{ 1, 2, 7, 10 });
+}
+
+TEST_CASE("unique long runs") {
+   //Long enough for the vectorised search to kick in
+   std::vector<double> v;
+   std::vector<double> expected;
+   for (int run = 0; run < 50; ++run) {
+      v.insert(v.end(), run % 7 + 1, run * 0.5);
+      expected.push_back(run * 0.5);
+   }
+   auto u = v | tl::views::unique;
+   static_assert(std::ranges::forward_range<decltype(u)>);
+   REQUIRE(tl::to<std::vector>(u) == expected);
+
+   std::vector<double> reference = v;
+   reference.erase(std::unique(reference.begin(), reference.end()), reference.end());
+   REQUIRE(reference == expected);
+}